@@ -0,0 +1,197 @@
+// ConfigManager_bench：在合成的 schema / 配置上测量核心路径的耗时
+//
+//   ConfigManager_bench [--depth N] [--width N] [--array N] [--string N]
+//                       [--iterations N] [--seed N] [--out 文件]
+//
+// 结果以 JSON 输出（默认到标准输出），每项给出迭代次数以及 min / median / mean / p95 / max（纳秒）。
+
+#include "synthetic.hpp"
+#include "../src/config.h"
+#include "../src/ui/node_table.hpp"
+#include "../src/ui/ui_utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    struct options {
+        bench::synthetic_params params;
+        int iterations = 20;
+        std::string out;
+    };
+
+    options parse_options(int argc, char* argv[]) {
+        options opts;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) throw std::invalid_argument("Missing value for " + arg);
+            std::string value = argv[++i];
+            if (arg == "--depth") opts.params.depth = std::stoi(value);
+            else if (arg == "--width") opts.params.width = std::stoi(value);
+            else if (arg == "--array") opts.params.array_length = std::stoi(value);
+            else if (arg == "--string") opts.params.string_size = std::stoi(value);
+            else if (arg == "--seed") opts.params.seed = static_cast<unsigned>(std::stoul(value));
+            else if (arg == "--iterations") opts.iterations = std::max(1, std::stoi(value));
+            else if (arg == "--out") opts.out = value;
+            else throw std::invalid_argument("Unknown option: " + arg);
+        }
+        return opts;
+    }
+
+    // 每次迭代执行 fn 共 batch 次，记录单次调用的平均耗时；batch 用于测量很短的函数
+    config::json measure(const std::string& name, int iterations, int batch, const std::function<void()>& fn) {
+        using clock = std::chrono::steady_clock;
+        fn();  // 预热
+        std::vector<double> samples;
+        samples.reserve(iterations);
+        for (int i = 0; i < iterations; ++i) {
+            auto start = clock::now();
+            for (int b = 0; b < batch; ++b) fn();
+            samples.push_back(std::chrono::duration<double, std::nano>(clock::now() - start).count() / batch);
+        }
+        std::sort(samples.begin(), samples.end());
+        auto percentile = [&](double p) {
+            return samples[std::min(samples.size() - 1, static_cast<size_t>(p * (samples.size() - 1) + 0.5))];
+        };
+        double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+
+        std::cerr << name << ": median " << percentile(0.5) / 1000.0 << " us" << std::endl;
+        return {
+            {"name", name},
+            {"iterations", iterations},
+            {"batch", batch},
+            {"min_ns", samples.front()},
+            {"median_ns", percentile(0.5)},
+            {"mean_ns", mean},
+            {"p95_ns", percentile(0.95)},
+            {"max_ns", samples.back()},
+        };
+    }
+
+    size_t count_nodes(const config::json& j) {
+        size_t n = 1;
+        if (j.is_structured()) {
+            for (const auto& child : j) n += count_nodes(child);
+        }
+        return n;
+    }
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        options opts = parse_options(argc, argv);
+        const auto& params = opts.params;
+
+        // 工作目录：schema.json 与 configs/ 放在同一目录下，和真实应用目录结构一致
+        fs::path work_dir = fs::temp_directory_path() / ("configmanager_bench_" + std::to_string(params.seed));
+        fs::create_directories(work_dir / "configs");
+        std::string schema_path = (work_dir / "schema.json").string();
+        std::string config_path = (work_dir / "configs" / "bench.json").string();
+        std::string save_path = (work_dir / "configs" / "bench_save.json").string();
+
+        config::json schema_doc = bench::make_schema(params);
+        {
+            std::ofstream ofs(schema_path);
+            ofs << schema_doc.dump(4);
+        }
+        config::json schema = config::load_schema(schema_path);
+        config::json cfg = bench::make_config(schema, params);
+        config::save_config(config_path, cfg);
+
+        std::string text = bench::make_text(params.string_size * 16, params.seed);
+        const int iterations = opts.iterations;
+
+        config::json results = config::json::array();
+        results.push_back(measure("load_config", iterations, 1, [&] {
+            auto loaded = config::load_config(config_path);
+        }));
+        results.push_back(measure("load_config_document", iterations, 1, [&] {
+            auto loaded = config::load_config_document(config_path);
+        }));
+        results.push_back(measure("save_config", iterations, 1, [&] {
+            config::save_config(save_path, cfg);
+        }));
+        results.push_back(measure("validate_config", iterations, 1, [&] {
+            config::validate_config(cfg, schema);
+        }));
+        auto registry = config::current_schema_registry();
+        config::schema_program program(schema, [&registry](const std::string& rel) -> const config::json& {
+            return registry->document(rel);
+        });
+        if (program.complete()) {
+            results.push_back(measure("validate_program_serial", iterations, 1, [&] {
+                std::vector<config::validation_error> errors;
+                program.run(cfg, errors);
+            }));
+            results.push_back(measure("validate_program_parallel", iterations, 1, [&] {
+                std::vector<config::validation_error> errors;
+                program.run_parallel(cfg, errors);
+            }));
+        }
+        results.push_back(measure("generate_default_config", iterations, 1, [&] {
+            config::clear_default_config_cache();
+            auto generated = config::generate_default_config(schema);
+        }));
+        results.push_back(measure("generate_default_config_cached", iterations, 1, [&] {
+            auto generated = config::generate_default_config(schema);
+        }));
+        ui::node_table nodes;
+        results.push_back(measure("build_node_table", iterations, 1, [&] {
+            nodes.build(cfg, schema);
+        }));
+        results.push_back(measure("node_table_labels", iterations, 1, [&] {
+            for (int row = 0; row < static_cast<int>(nodes.size()); row++) auto label = nodes.label(row);
+        }));
+        results.push_back(measure("wrap_paragraph", iterations, 100, [&] {
+            auto lines = ui::wrap_paragraph(text, 56);
+        }));
+        results.push_back(measure("utf8_display_width", iterations, 1000, [&] {
+            volatile int width = ui::utf8_display_width(text);
+            (void)width;
+        }));
+
+        config::json report = {
+            {"params", {
+                {"depth", params.depth},
+                {"width", params.width},
+                {"array_length", params.array_length},
+                {"string_size", params.string_size},
+                {"seed", params.seed},
+            }},
+            {"sizes", {
+                {"schema_bytes", schema.dump().size()},
+                {"config_bytes", fs::file_size(config_path)},
+                {"config_nodes", count_nodes(cfg)},
+                {"menu_rows", nodes.size()},
+                {"text_bytes", text.size()},
+            }},
+            {"results", std::move(results)},
+        };
+
+        if (opts.out.empty()) {
+            std::cout << report.dump(2) << std::endl;
+        } else {
+            std::ofstream ofs(opts.out);
+            if (!ofs.is_open()) throw std::runtime_error("Cannot open output file: " + opts.out);
+            ofs << report.dump(2) << std::endl;
+        }
+
+        fs::remove_all(work_dir);
+    } catch (const std::exception& e) {
+        std::cerr << "基准测试失败: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
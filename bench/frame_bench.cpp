@@ -0,0 +1,305 @@
+// ConfigManager_frame_bench：无终端地驱动主界面和编辑界面，回放按键脚本并统计每个事件的延迟
+//
+//   ConfigManager_frame_bench [--depth N] [--width N] [--array N] [--string N] [--files N]
+//                             [--screen 宽x高] [--script 文件] [--seed N] [--out 文件]
+//
+// 每个事件的耗时包括：组件处理事件、视图切换、构建元素树、布局、绘制到离屏 Screen 并生成输出字符串，
+// 即 ScreenInteractive 在一次按键后所做的全部工作。结果以 JSON 输出，按事件类型给出 p50 / p90 / p99 / max（微秒）
+// 以及进程的峰值内存。
+//
+// 脚本每行一个步骤，# 开头为注释：
+//   down [次数]      按键：up down left right pageup pagedown home end return tab tabreverse escape backspace delete
+//   text 字符串      逐字符输入
+//   open 文件名      打开配置目录下的文件进入编辑界面
+//   main             回到主界面
+
+#include "synthetic.hpp"
+#include "../src/config.h"
+#include "../src/ui/navigator.hpp"
+#include <ftxui/component/event.hpp>
+#include <ftxui/dom/node.hpp>
+#include <ftxui/screen/screen.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace fs = std::filesystem;
+using namespace ftxui;
+
+namespace {
+
+    // 默认脚本：浏览文件列表，打开大配置，浏览、搜索、编辑、增删数组项并保存
+    const char* const default_script = R"(# 主界面
+down 8
+up 8
+open bench.json
+# 搜索框 -> 菜单，逐项浏览
+tab
+down 200
+pagedown 5
+up 100
+end
+home
+# 搜索与 JSON Pointer 跳转
+tabreverse
+text field_1
+backspace 7
+text /field_2_6/0
+backspace 12
+tab
+# 选中数组元素，在右侧添加、删除数组项
+down 7
+right
+return
+tab
+return
+tab
+return
+# 编辑值并更新
+left
+down 2
+right
+text 42
+tab
+return
+# 保存
+tab
+return
+main
+down 1
+)";
+
+    struct step {
+        std::string label;  // 统计分组
+        std::vector<Event> events;
+        std::string open_file;
+        bool to_main = false;
+    };
+
+    std::map<std::string, Event> key_events() {
+        return {
+            {"up", Event::ArrowUp}, {"down", Event::ArrowDown},
+            {"left", Event::ArrowLeft}, {"right", Event::ArrowRight},
+            {"pageup", Event::PageUp}, {"pagedown", Event::PageDown},
+            {"home", Event::Home}, {"end", Event::End},
+            {"return", Event::Return}, {"tab", Event::Tab}, {"tabreverse", Event::TabReverse},
+            {"escape", Event::Escape}, {"backspace", Event::Backspace}, {"delete", Event::Delete},
+        };
+    }
+
+    std::vector<step> parse_script(std::istream& in) {
+        static const auto keys = key_events();
+        std::vector<step> steps;
+        std::string line;
+        int line_no = 0;
+        while (std::getline(in, line)) {
+            ++line_no;
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream iss(line);
+            std::string word;
+            iss >> word;
+            std::string rest;
+            std::getline(iss >> std::ws, rest);
+
+            if (word == "text") {
+                // 按 UTF-8 字符拆分
+                for (size_t i = 0; i < rest.size();) {
+                    size_t len = 1;
+                    unsigned char c = rest[i];
+                    if (c >= 0xf0) len = 4;
+                    else if (c >= 0xe0) len = 3;
+                    else if (c >= 0xc0) len = 2;
+                    steps.push_back({"char", {Event::Character(rest.substr(i, len))}, "", false});
+                    i += len;
+                }
+            } else if (word == "open") {
+                steps.push_back({"open", {}, rest, false});
+            } else if (word == "main") {
+                steps.push_back({"main", {}, "", true});
+            } else if (keys.count(word)) {
+                int count = rest.empty() ? 1 : std::stoi(rest);
+                for (int i = 0; i < count; ++i) steps.push_back({word, {keys.at(word)}, "", false});
+            } else {
+                throw std::invalid_argument("Unknown script step at line " + std::to_string(line_no) + ": " + word);
+            }
+        }
+        return steps;
+    }
+
+    long peak_memory_kb() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return static_cast<long>(counters.PeakWorkingSetSize / 1024);
+        }
+        return 0;
+#else
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;  // Linux 上单位为 KB
+#endif
+    }
+
+    config::json summarize(std::vector<double> samples) {
+        std::sort(samples.begin(), samples.end());
+        auto percentile = [&](double p) {
+            return samples[std::min(samples.size() - 1, static_cast<size_t>(p * (samples.size() - 1) + 0.5))];
+        };
+        return {
+            {"count", samples.size()},
+            {"p50_us", percentile(0.5)},
+            {"p90_us", percentile(0.9)},
+            {"p99_us", percentile(0.99)},
+            {"max_us", samples.back()},
+        };
+    }
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        bench::synthetic_params params;
+        int file_count = 20;
+        int screen_width = 160, screen_height = 50;
+        std::string script_path, out_path;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) throw std::invalid_argument("Missing value for " + arg);
+            std::string value = argv[++i];
+            if (arg == "--depth") params.depth = std::stoi(value);
+            else if (arg == "--width") params.width = std::stoi(value);
+            else if (arg == "--array") params.array_length = std::stoi(value);
+            else if (arg == "--string") params.string_size = std::stoi(value);
+            else if (arg == "--seed") params.seed = static_cast<unsigned>(std::stoul(value));
+            else if (arg == "--files") file_count = std::max(1, std::stoi(value));
+            else if (arg == "--screen") {
+                if (std::sscanf(value.c_str(), "%dx%d", &screen_width, &screen_height) != 2) {
+                    throw std::invalid_argument("Invalid screen size: " + value);
+                }
+            }
+            else if (arg == "--script") script_path = value;
+            else if (arg == "--out") out_path = value;
+            else throw std::invalid_argument("Unknown option: " + arg);
+        }
+
+        std::vector<step> steps;
+        if (script_path.empty()) {
+            std::istringstream iss(default_script);
+            steps = parse_script(iss);
+        } else {
+            std::ifstream ifs(script_path);
+            if (!ifs.is_open()) throw std::runtime_error("Cannot open script file: " + script_path);
+            steps = parse_script(ifs);
+        }
+
+        // 应用目录：schema.json + configs/，bench.json 为大配置，其余为默认配置
+        fs::path work_dir = fs::temp_directory_path() / ("configmanager_frame_bench_" + std::to_string(params.seed));
+        fs::remove_all(work_dir);
+        fs::create_directories(work_dir / "configs");
+        std::string schema_path = (work_dir / "schema.json").string();
+        {
+            std::ofstream ofs(schema_path);
+            ofs << bench::make_schema(params).dump(4);
+        }
+        config::set_default_config_dir((work_dir / "configs").string());
+        config::json schema = config::load_schema(schema_path);
+        config::save_config(config::get_default_config_dir() + "/bench.json", bench::make_config(schema, params));
+        config::json defaults = config::generate_default_config(schema);
+        for (int i = 1; i < file_count; ++i) {
+            config::save_config(config::get_default_config_dir() + "/config_" + std::to_string(i) + ".json", defaults);
+        }
+        long baseline_kb = peak_memory_kb();
+
+        // 导航器：对话框替换为非交互实现。删除配置文件时回答否，保证脚本后续步骤仍有数据可用
+        ui::navigator nav("bench", schema);
+        nav.confirm = [](const std::string&, const std::string& message) {
+            return message.find("配置文件") == std::string::npos;
+        };
+        nav.warn = [](const std::string&, const std::string&) {};
+        int created = 0;
+        nav.ask_filename = [&created](const std::vector<std::string>&) {
+            return "created_" + std::to_string(++created);
+        };
+
+        auto screen = Screen::Create(Dimension::Fixed(screen_width), Dimension::Fixed(screen_height));
+        auto root = nav.root();
+        auto draw = [&] {
+            Element document = root->Render();
+            Render(screen, document);
+            volatile size_t output_size = screen.ToString().size();
+            (void)output_size;
+        };
+
+        nav.show_main();
+        draw();
+
+        using clock = std::chrono::steady_clock;
+        std::map<std::string, std::vector<double>> samples;
+        std::vector<double> all;
+        for (const auto& s : steps) {
+            if (nav.exited()) break;
+            auto start = clock::now();
+            if (!s.open_file.empty()) {
+                nav.show_editor(config::get_default_config_dir() + "/" + s.open_file);
+            } else if (s.to_main) {
+                nav.show_main();
+            }
+            for (const auto& event : s.events) root->OnEvent(event);
+            nav.apply_pending();
+            draw();
+            double us = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+            samples[s.label].push_back(us);
+            all.push_back(us);
+        }
+
+        config::json per_event = config::json::object();
+        for (auto& [label, values] : samples) per_event[label] = summarize(values);
+
+        config::json report = {
+            {"params", {
+                {"depth", params.depth},
+                {"width", params.width},
+                {"array_length", params.array_length},
+                {"string_size", params.string_size},
+                {"files", file_count},
+                {"screen", std::to_string(screen_width) + "x" + std::to_string(screen_height)},
+                {"script", script_path.empty() ? "(default)" : script_path},
+            }},
+            {"config_bytes", fs::file_size(config::get_default_config_dir() + "/bench.json")},
+            {"events", all.empty() ? config::json(nullptr) : summarize(all)},
+            {"per_event", std::move(per_event)},
+            {"baseline_memory_kb", baseline_kb},
+            {"peak_memory_kb", peak_memory_kb()},
+        };
+
+        if (out_path.empty()) {
+            std::cout << report.dump(2) << std::endl;
+        } else {
+            std::ofstream ofs(out_path);
+            if (!ofs.is_open()) throw std::runtime_error("Cannot open output file: " + out_path);
+            ofs << report.dump(2) << std::endl;
+        }
+
+        fs::remove_all(work_dir);
+    } catch (const std::exception& e) {
+        std::cerr << "帧耗时测试失败: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+#include "synthetic.hpp"
+#include <random>
+
+namespace bench {
+
+    namespace {
+
+        const char* const cjk[] = {"配", "置", "管", "理", "默", "认", "数", "值", "路", "径"};
+
+        std::string make_string(int length, std::mt19937& rng) {
+            std::string out;
+            std::uniform_int_distribution<int> pick(0, 15);
+            for (int i = 0; i < length; ++i) {
+                int r = pick(rng);
+                if (r < 4) out += cjk[r + (i % 6)];
+                else if (r == 4 && i > 0 && i + 1 < length) out += ' ';
+                else out += static_cast<char>('a' + (r * 7 + i) % 26);
+            }
+            return out;
+        }
+
+        config::json make_object_schema(int depth, const synthetic_params& params, std::mt19937& rng) {
+            config::json schema = {{"type", "object"}, {"properties", config::json::object()}};
+            config::json required = config::json::array();
+            for (int i = 0; i < params.width; ++i) {
+                std::string key = "field_" + std::to_string(depth) + "_" + std::to_string(i);
+                config::json prop;
+                // 最深一层没有对象和数组
+                int kind = depth > 0 ? i % 7 : i % 5;
+                switch (kind) {
+                    case 0:
+                        prop = {{"type", "string"}, {"maxLength", params.string_size * 4},
+                                {"default", make_string(params.string_size, rng)}};
+                        break;
+                    case 1:
+                        prop = {{"type", "integer"}, {"minimum", 0}, {"maximum", 1 << 20}, {"default", i}};
+                        break;
+                    case 2:
+                        prop = {{"type", "number"}, {"minimum", 0}, {"default", 0.5 * i}};
+                        break;
+                    case 3:
+                        prop = {{"type", "boolean"}, {"default", i % 2 == 0}};
+                        break;
+                    case 4:
+                        prop = {{"type", "string"}, {"enum", {"alpha", "beta", "gamma", "delta"}}, {"default", "alpha"}};
+                        break;
+                    case 5:
+                        prop = make_object_schema(depth - 1, params, rng);
+                        break;
+                    default:
+                        prop = {{"type", "array"}, {"items", make_object_schema(depth - 1, params, rng)}};
+                        break;
+                }
+                prop["title"] = key;
+                prop["description"] = make_string(params.string_size * 2, rng);
+                schema["properties"][key] = std::move(prop);
+                required.push_back(key);
+            }
+            schema["required"] = std::move(required);
+            return schema;
+        }
+
+        config::json make_value(const config::json& schema, const synthetic_params& params, std::mt19937& rng) {
+            const std::string type = schema.value("type", "");
+            if (type == "object") {
+                config::json obj = config::json::object();
+                for (auto it = schema["properties"].begin(); it != schema["properties"].end(); ++it) {
+                    obj[it.key()] = make_value(it.value(), params, rng);
+                }
+                return obj;
+            }
+            if (type == "array") {
+                config::json arr = config::json::array();
+                for (int i = 0; i < params.array_length; ++i) {
+                    arr.push_back(make_value(schema["items"], params, rng));
+                }
+                return arr;
+            }
+            if (type == "string" && schema.contains("enum")) {
+                return schema["enum"][rng() % schema["enum"].size()];
+            }
+            if (type == "string") return make_string(params.string_size, rng);
+            if (type == "integer") return static_cast<int>(rng() % 1000);
+            if (type == "number") return static_cast<double>(rng() % 1000) / 8.0;
+            if (type == "boolean") return rng() % 2 == 0;
+            return nullptr;
+        }
+
+    }  // namespace
+
+    config::json make_schema(const synthetic_params& params) {
+        std::mt19937 rng(params.seed);
+        config::json schema = make_object_schema(params.depth, params, rng);
+        schema["$schema"] = "http://json-schema.org/draft-07/schema#";
+        schema["title"] = "synthetic";
+        return schema;
+    }
+
+    config::json make_config(const config::json& schema, const synthetic_params& params) {
+        std::mt19937 rng(params.seed + 1);
+        return make_value(schema, params, rng);
+    }
+
+    std::string make_text(int length, unsigned seed) {
+        std::mt19937 rng(seed);
+        return make_string(length, rng);
+    }
+
+}  // namespace bench
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include "../src/config.h"
+
+namespace bench {
+
+    // 合成 schema / 配置的规模参数
+    struct synthetic_params {
+        int depth = 3;          // 对象嵌套层数
+        int width = 8;          // 每层属性数
+        int array_length = 16;  // 数组元素个数
+        int string_size = 32;   // 字符串长度（字符数，约四分之一为中文）
+        unsigned seed = 1;
+    };
+
+    // 生成 schema：每层依次循环 string / integer / number / boolean / enum / object / array 属性，
+    // 带 description、default、minimum 等编辑器和校验器都会用到的关键字
+    config::json make_schema(const synthetic_params& params);
+
+    // 按 schema 生成一份合法的配置，数组填满 array_length 个元素
+    config::json make_config(const config::json& schema, const synthetic_params& params);
+
+    // 中英文混排的文本，用于测量换行和显示宽度
+    std::string make_text(int length, unsigned seed);
+
+}  // namespace bench
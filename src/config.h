@@ -1,6 +1,19 @@
 #pragma once
 
+#include "config/json_type.hpp"
+#include "config/document.hpp"
 #include "config/config_file.hpp"
 #include "config/template_generator.hpp"
 #include "config/schema_loader.hpp"
-#include "config/validator.hpp"
\ No newline at end of file
+#include "config/schema_registry.hpp"
+#include "config/validator.hpp"
+#include "config/tree_hash.hpp"
+#include "config/layered_config.hpp"
+#include "config/config_index.hpp"
+#include "config/workspace.hpp"
+#include "config/history.hpp"
+#include "config/array_ops.hpp"
+#include "config/schema_program.hpp"
+#include "config/schema_diff.hpp"
+#include "config/schema_watcher.hpp"
+#include "config/migration.hpp"
\ No newline at end of file
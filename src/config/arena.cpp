@@ -0,0 +1,68 @@
+#include "arena.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace config {
+
+    namespace {
+        constexpr size_t alignment = alignof(std::max_align_t);
+        constexpr size_t header = (sizeof(void*) + sizeof(size_t) + alignment - 1) / alignment * alignment;
+        constexpr size_t max_block_size = 8 * 1024 * 1024;
+    }
+
+    arena::arena(size_t first_block_size) : next_size_(std::max<size_t>(first_block_size, 1024)) {}
+
+    arena::~arena() {
+        // 仍有从本内存区分配的对象未析构：通常是节点被 std::move 到了所属文档之外，析构后它会指向已归还的内存
+        assert(live_ == 0 && "arena destroyed while nodes allocated from it are still alive");
+        while (head_) {
+            block* next = head_->next;
+            ::operator delete(head_);
+            head_ = next;
+        }
+    }
+
+    arena::block* arena::new_block(size_t size) {
+        auto* b = static_cast<block*>(::operator new(header + size));
+        b->size = size;
+        return b;
+    }
+
+    void* arena::allocate(size_t size) {
+        size = (size + alignment - 1) / alignment * alignment;
+        used_ += size;
+#ifndef NDEBUG
+        ++live_;
+#endif
+        if (static_cast<size_t>(end_ - cur_) >= size) {
+            void* p = cur_;
+            cur_ += size;
+            return p;
+        }
+
+        // 大块单独分配，挂在当前块之后，当前块剩余空间继续使用
+        if (size > next_size_ / 4) {
+            block* b = new_block(size);
+            if (head_) {
+                b->next = head_->next;
+                head_->next = b;
+            } else {
+                b->next = nullptr;
+                head_ = b;
+            }
+            return reinterpret_cast<char*>(b) + header;
+        }
+
+        // 每个新块是上一块的两倍，块数随文档大小对数增长
+        block* b = new_block(next_size_);
+        b->next = head_;
+        head_ = b;
+        cur_ = reinterpret_cast<char*>(b) + header;
+        end_ = cur_ + next_size_;
+        next_size_ = std::min(next_size_ * 2, max_block_size);
+        void* p = cur_;
+        cur_ += size;
+        return p;
+    }
+
+}  // namespace config
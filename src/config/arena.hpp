@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace config {
+
+    // 单调增长的内存区：只分配不单独释放，析构时整体归还所有内存块
+    // 不是线程安全的，只在创建它的线程上通过 arena_scope 使用
+    class arena {
+    public:
+        explicit arena(size_t first_block_size = 64 * 1024);
+        ~arena();
+
+        arena(const arena&) = delete;
+        arena& operator=(const arena&) = delete;
+
+        // 按 alignof(std::max_align_t) 对齐
+        void* allocate(size_t size);
+
+        // 已分配出去的字节数
+        size_t bytes_used() const { return used_; }
+
+        // arena_allocator 释放本内存区中的一块内存时调用。内存本身不归还；
+        // 调试构建中据此统计仍在使用的分配，内存区析构时必须为零
+        void release() noexcept {
+#ifndef NDEBUG
+            --live_;
+#endif
+        }
+
+    private:
+        struct block {
+            block* next;
+            size_t size;
+        };
+
+        block* new_block(size_t size);
+
+        block* head_ = nullptr;
+        char* cur_ = nullptr;
+        char* end_ = nullptr;
+        size_t next_size_;
+        size_t used_ = 0;
+#ifndef NDEBUG
+        size_t live_ = 0;
+#endif
+    };
+
+    namespace detail {
+        // 当前线程上正在使用的内存区（由 arena_scope 设置）
+        inline thread_local arena* current_arena = nullptr;
+    }
+
+    // 作用域内当前线程上 config::json 的分配都来自指定内存区
+    class arena_scope {
+    public:
+        explicit arena_scope(arena& a) : previous_(detail::current_arena) { detail::current_arena = &a; }
+        ~arena_scope() { detail::current_arena = previous_; }
+
+        arena_scope(const arena_scope&) = delete;
+        arena_scope& operator=(const arena_scope&) = delete;
+
+    private:
+        arena* previous_;
+    };
+
+    // config::json 使用的分配器（无状态，可作为 basic_json 的 AllocatorType）
+    // 有 arena_scope 时从内存区分配，否则从堆分配。每块内存前有一个标记头，
+    // 释放时据此判断：堆内存立即归还，内存区中的内存留待内存区整体释放。
+    // 标记头第二个字记录所属内存区，释放时通知它（调试构建据此检查内存区析构时没有仍在使用的节点）。
+    template <class T>
+    struct arena_allocator {
+        using value_type = T;
+
+        static constexpr size_t header_size =
+            alignof(std::max_align_t) >= 2 * sizeof(uintptr_t) ? alignof(std::max_align_t) : 2 * sizeof(uintptr_t);
+
+        arena_allocator() noexcept = default;
+        template <class U>
+        arena_allocator(const arena_allocator<U>&) noexcept {}
+
+        T* allocate(size_t n) {
+            static_assert(alignof(T) <= header_size, "over-aligned types are not supported");
+            size_t bytes = n * sizeof(T) + header_size;
+            char* p;
+            if (arena* a = detail::current_arena) {
+                p = static_cast<char*>(a->allocate(bytes));
+                reinterpret_cast<uintptr_t*>(p)[0] = from_arena;
+                reinterpret_cast<uintptr_t*>(p)[1] = reinterpret_cast<uintptr_t>(a);
+            } else {
+                p = static_cast<char*>(::operator new(bytes));
+                *reinterpret_cast<uintptr_t*>(p) = from_heap;
+            }
+            return reinterpret_cast<T*>(p + header_size);
+        }
+
+        void deallocate(T* ptr, size_t) noexcept {
+            char* p = reinterpret_cast<char*>(ptr) - header_size;
+            const uintptr_t* header = reinterpret_cast<const uintptr_t*>(p);
+            if (header[0] == from_heap) {
+                ::operator delete(p);
+            } else {
+                reinterpret_cast<arena*>(header[1])->release();
+            }
+        }
+
+        template <class U>
+        bool operator==(const arena_allocator<U>&) const noexcept { return true; }
+        template <class U>
+        bool operator!=(const arena_allocator<U>&) const noexcept { return false; }
+
+    private:
+        static constexpr uintptr_t from_heap = 0x48454150;   // "HEAP"
+        static constexpr uintptr_t from_arena = 0x4152454e;  // "AREN"
+    };
+
+}  // namespace config
@@ -0,0 +1,142 @@
+#include "array_ops.hpp"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+namespace config {
+
+    namespace {
+
+        std::string trim(const std::string& s) {
+            size_t begin = s.find_first_not_of(" \t\r\n");
+            if (begin == std::string::npos) return "";
+            size_t end = s.find_last_not_of(" \t\r\n");
+            return s.substr(begin, end - begin + 1);
+        }
+
+        size_t parse_range_index(const std::string& s, const std::string& spec) {
+            try {
+                return parse_index(s);
+            } catch (const std::exception&) {
+                throw std::runtime_error("Invalid index range: " + spec);
+            }
+        }
+
+        json::array_t& elements(json& array) {
+            if (!array.is_array()) {
+                throw std::runtime_error("Not an array");
+            }
+            return array.get_ref<json::array_t&>();
+        }
+
+    }  // namespace
+
+    size_t parse_index(const std::string& text) {
+        std::string t = trim(text);
+        if (t.empty() || !std::all_of(t.begin(), t.end(), [](unsigned char c) { return std::isdigit(c); })) {
+            throw std::runtime_error("Invalid index: " + text);
+        }
+        try {
+            return std::stoull(t);
+        } catch (const std::out_of_range&) {
+            throw std::runtime_error("Index out of range: " + t);
+        }
+    }
+
+    std::vector<size_t> parse_index_ranges(const std::string& spec, size_t size) {
+        std::vector<size_t> indices;
+        std::stringstream ss(spec);
+        for (std::string part; std::getline(ss, part, ',');) {
+            if (trim(part).empty()) continue;
+            size_t dash = part.find('-');
+            size_t first = parse_range_index(part.substr(0, dash), spec);
+            size_t last = dash == std::string::npos ? first : parse_range_index(part.substr(dash + 1), spec);
+            if (first > last) {
+                throw std::runtime_error("Invalid index range: " + trim(part));
+            }
+            if (last >= size) {
+                throw std::runtime_error("Index range out of bounds: " + trim(part) + " (size " + std::to_string(size) + ")");
+            }
+            for (size_t i = first; i <= last; ++i) indices.push_back(i);
+        }
+        if (indices.empty()) {
+            throw std::runtime_error("Empty index range");
+        }
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+        return indices;
+    }
+
+    std::vector<json> parse_items(const std::string& text) {
+        std::vector<json> items;
+        std::string body = trim(text);
+        if (!body.empty() && body[0] == '[') {
+            json parsed;
+            try {
+                parsed = json::parse(body);
+            } catch (const std::exception& e) {
+                throw std::runtime_error("Failed to parse JSON array: " + std::string(e.what()));
+            }
+            for (auto& item : parsed) items.push_back(std::move(item));
+            return items;
+        }
+
+        std::istringstream lines(body);
+        size_t line_no = 0;
+        for (std::string line; std::getline(lines, line);) {
+            ++line_no;
+            if (trim(line).empty()) continue;
+            try {
+                items.push_back(json::parse(line));
+            } catch (const std::exception& e) {
+                throw std::runtime_error("Failed to parse NDJSON line " + std::to_string(line_no) + ": " + e.what());
+            }
+        }
+        return items;
+    }
+
+    std::vector<json> load_items(const std::string& path) {
+        std::ifstream ifs(path, std::ios::binary);
+        if (!ifs.is_open()) {
+            throw std::runtime_error("Cannot open items file: " + path);
+        }
+        std::string text((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        return parse_items(text);
+    }
+
+    void erase_items(json& array, const std::vector<size_t>& indices) {
+        auto& vec = elements(array);
+        // 一次前移压缩：保留的元素依次移到前面，末尾整体截断
+        size_t write = 0, next = 0;
+        for (size_t read = 0; read < vec.size(); ++read) {
+            if (next < indices.size() && indices[next] == read) {
+                ++next;
+                continue;
+            }
+            if (write != read) vec[write] = std::move(vec[read]);
+            ++write;
+        }
+        vec.erase(vec.begin() + static_cast<std::ptrdiff_t>(write), vec.end());
+    }
+
+    void insert_items(json& array, size_t position, std::vector<json> items) {
+        if (array.is_null()) array = json::array();
+        auto& vec = elements(array);
+        position = std::min(position, vec.size());
+        vec.insert(vec.begin() + static_cast<std::ptrdiff_t>(position),
+                   std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+    }
+
+    void move_items(json& array, const std::vector<size_t>& indices, size_t position) {
+        auto& vec = elements(array);
+        std::vector<json> moved;
+        moved.reserve(indices.size());
+        for (size_t i : indices) moved.push_back(std::move(vec[i]));
+        erase_items(array, indices);
+        insert_items(array, position, std::move(moved));
+    }
+
+}  // namespace config
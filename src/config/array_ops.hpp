@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "json_type.hpp"
+
+namespace config {
+
+    // 数组的批量操作：每个函数对数组只做一次整体修改（一次搬移），而不是逐项增删
+
+    // 单次批量插入的最大项数，超过时在分配之前拒绝
+    constexpr size_t max_bulk_items = 100000;
+
+    // 解析非负整数（下标、数量），只接受数字（首尾空白忽略），"-1"、"+3"、"1e3" 等都抛异常
+    size_t parse_index(const std::string& text);
+
+    // 解析下标范围，如 "0-9,15"（闭区间，逗号分隔），返回升序去重的下标；格式错误或越界时抛异常
+    std::vector<size_t> parse_index_ranges(const std::string& spec, size_t size);
+
+    // 解析多个数组项：以 [ 开头时按 JSON 数组解析，每个元素为一项；否则按 NDJSON，每个非空行为一项
+    std::vector<json> parse_items(const std::string& text);
+
+    // 读取文件并按 parse_items 解析
+    std::vector<json> load_items(const std::string& path);
+
+    // 删除 indices（升序、去重）处的元素
+    void erase_items(json& array, const std::vector<size_t>& indices);
+
+    // 在 position 处插入 items（position 超出末尾时追加）
+    void insert_items(json& array, size_t position, std::vector<json> items);
+
+    // 将 indices（升序、去重）处的元素保持原有顺序移动到 position；
+    // position 是这些元素移走之后数组中的位置，超出末尾时移到末尾
+    void move_items(json& array, const std::vector<size_t>& indices, size_t position);
+
+}  // namespace config
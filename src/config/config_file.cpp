@@ -1,5 +1,9 @@
 #include "config_file.hpp"
+#include "layered_config.hpp"
+#include "history.hpp"
 #include "../utils/fs.hpp"
+#include "../utils/trace.hpp"
+#include <algorithm>
 #include <fstream>
 #include <stdexcept>
 #include <string>
@@ -52,20 +56,17 @@ namespace config {
         return (fs::path(get_default_config_dir()) / "active").string();
     }
 
-    std::string detect_default_config_dir(const std::string& app_name) {
+    std::string config_home() {
     #ifdef _WIN32
         std::string appdata = get_env_var("APPDATA");
-        std::string path;
         if (!appdata.empty()) {
-            path = appdata + "\\" + app_name + "\\configs";
-        } else {
-            char userprofile[MAX_PATH];
-            if (SUCCEEDED(SHGetFolderPathA(NULL, CSIDL_PROFILE, NULL, 0, userprofile))) {
-                path = std::string(userprofile) + "\\AppData\\Roaming\\" + app_name + "\\configs";
-            } else {
-                path = ".\\configs";
-            }
+            return appdata;
+        }
+        char userprofile[MAX_PATH];
+        if (SUCCEEDED(SHGetFolderPathA(NULL, CSIDL_PROFILE, NULL, 0, userprofile))) {
+            return std::string(userprofile) + "\\AppData\\Roaming";
         }
+        return ".";
     #else
         const char* xdg_config_home = std::getenv("XDG_CONFIG_HOME");
         std::string base;
@@ -79,13 +80,20 @@ namespace config {
                 base = ".";
             }
         }
-        std::string path = base + "/" + app_name + "/configs";
+        return base;
     #endif
+    }
 
-        return path;
+    std::string detect_default_config_dir(const std::string& app_name) {
+    #ifdef _WIN32
+        return config_home() + "\\" + app_name + "\\configs";
+    #else
+        return config_home() + "/" + app_name + "/configs";
+    #endif
     }
 
     json load_config(const std::string& path) {
+        TRACE_SCOPE("load_config", "config", path);
         std::ifstream ifs(path);
         if (!ifs.is_open()) {
             throw std::runtime_error("Cannot open config file: " + path);
@@ -99,13 +107,53 @@ namespace config {
         return j;
     }
 
+    document load_config_document(const std::string& path) {
+        TRACE_SCOPE("load_config_document", "config", path);
+        std::ifstream ifs(path, std::ios::binary);
+        if (!ifs.is_open()) {
+            throw std::runtime_error("Cannot open config file: " + path);
+        }
+        std::string text((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        try {
+            return document::parse(text);
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Failed to parse config JSON: " + std::string(e.what()));
+        }
+    }
+
+    std::string refresh_active_merged(const std::string& configs_dir, const std::vector<std::string>& changed_paths) {
+        std::string target = utils::filesystem::read_symlink((fs::path(configs_dir) / "active").string());
+        if (target.empty()) return "";
+        fs::path active(target);
+        if (active.is_relative()) active = fs::path(configs_dir) / active;
+        if (active.parent_path().filename() != ".merged") return "";
+
+        std::string source = (active.parent_path().parent_path() / active.filename()).string();
+        std::error_code ec;
+        if (!fs::exists(source, ec)) return "";
+        for (const auto& layer : config_layer_paths(source)) {
+            for (const auto& changed : changed_paths) {
+                if (fs::equivalent(layer, changed, ec)) {
+                    materialize_merged_config(source);
+                    return source;
+                }
+            }
+        }
+        return "";
+    }
+
     void save_config(const std::string& path, const json& config) {
-        std::ofstream ofs(path);
-        if (!ofs.is_open()) {
-            throw std::runtime_error("Cannot open config file for writing: " + path);
+        TRACE_SCOPE("save_config", "config", path);
+        // 临时文件 + rename：轮询配置的进程不会读到截断或写了一半的文件
+        utils::filesystem::write_file_atomic(path, config.dump(4));
+
+        // 当前应用 configs 目录下的配置记入版本历史
+        std::error_code ec;
+        if (!default_config_dir.empty() && fs::equivalent(fs::path(path).parent_path(), default_config_dir, ec)) {
+            default_version_store().record("save", fs::path(path).filename().string(), config);
+            // 激活的是以它为某一层的合并结果时重新生成，否则 active 仍指向保存前的内容
+            refresh_active_merged(default_config_dir, {path});
         }
-        ofs << config.dump(4);
-        ofs.close();
     }
 
     std::string get_active_config_path() {
@@ -117,15 +165,88 @@ namespace config {
     }
 
     void set_active_config(const std::string& config_path) {
-        if (!fs::exists(config_path)) {
-            throw std::runtime_error("Config file does not exist: " + config_path);
+        set_active_configs({{configs_dir(), config_path}});
+    }
+
+    void set_active_configs(const std::vector<activation>& items) {
+        TRACE_SCOPE("set_active_configs", "config", std::to_string(items.size()));
+        struct prepared {
+            std::string link;
+            std::string staged;
+            std::string merged;         // 分层配置：合并结果的目标路径
+            std::string merged_staged;  // 以及暂存它的临时文件
+            json content;
+        };
+        std::vector<prepared> ready;
+        auto discard = [&ready] {
+            std::error_code ec;
+            for (const auto& p : ready) {
+                fs::remove(p.staged, ec);
+                if (!p.merged_staged.empty()) fs::remove(p.merged_staged, ec);
+            }
+        };
+
+        // 准备：此时各应用的 active 都还没有变化
+        try {
+            for (const auto& item : items) {
+                if (!fs::exists(item.config_path)) {
+                    throw std::runtime_error("Config file does not exist: " + item.config_path);
+                }
+                // 分层配置激活的是合并后的结果，消费者无需理解分层。
+                // 合并结果只暂存到临时文件，切换阶段才换上：active 可能已经指向它，批量中途失败时不能改变它的内容
+                prepared p;
+                p.content = load_config(item.config_path);
+                std::string target = item.config_path;
+                if (is_layered(p.content)) {
+                    staged_merged_config merged = stage_merged_config(item.config_path);
+                    target = p.merged = merged.target;
+                    p.merged_staged = merged.staged;
+                    p.content = std::move(merged.content);
+                }
+                p.link = (fs::path(item.configs_dir) / "active").string();
+                p.staged = utils::filesystem::stage_symlink(target, p.link);
+                if (p.staged.empty()) {
+                    std::error_code ec;
+                    if (!p.merged_staged.empty()) fs::remove(p.merged_staged, ec);
+                    throw std::runtime_error("Failed to create symlink: " + p.link + " -> " + target);
+                }
+                ready.push_back(std::move(p));
+            }
+        } catch (...) {
+            discard();
+            throw;
         }
-        if (utils::filesystem::is_symlink(active_link_path())) {
-            utils::filesystem::remove_symlink(active_link_path());
+
+        // 切换：合并结果和每个 active 都由 rename 原子替换，读者看不到文件写到一半或链接缺失的瞬间
+        std::vector<std::string> dirs;
+        for (size_t i = 0; i < ready.size(); ++i) {
+            std::string error;
+            if (!ready[i].merged_staged.empty()) {
+                try {
+                    utils::filesystem::commit_file(ready[i].merged_staged, ready[i].merged);
+                    ready[i].merged_staged.clear();
+                    std::string dir = fs::path(ready[i].merged).parent_path().string();
+                    if (std::find(dirs.begin(), dirs.end(), dir) == dirs.end()) dirs.push_back(dir);
+                } catch (const std::exception& e) {
+                    error = e.what();
+                }
+            }
+            if (error.empty() && !utils::filesystem::commit_symlink(ready[i].staged, ready[i].link)) {
+                error = "Failed to replace symlink: " + ready[i].link;
+            }
+            if (!error.empty()) {
+                ready.erase(ready.begin(), ready.begin() + i);  // 已切换的保留，只清理尚未切换的
+                discard();
+                throw std::runtime_error(error);
+            }
+            std::string dir = fs::path(ready[i].link).parent_path().string();
+            if (std::find(dirs.begin(), dirs.end(), dir) == dirs.end()) dirs.push_back(dir);
         }
-        bool ok = utils::filesystem::create_symlink(config_path, active_link_path());
-        if (!ok) {
-            throw std::runtime_error("Failed to create symlink: " + active_link_path() + " -> " + config_path);
+        for (const auto& dir : dirs) utils::filesystem::sync_dir(dir);
+
+        for (size_t i = 0; i < items.size(); ++i) {
+            version_store_for(fs::path(items[i].configs_dir).parent_path().string())
+                .record("activate", fs::path(items[i].config_path).filename().string(), ready[i].content);
         }
     }
 
@@ -1,33 +1,55 @@
 #pragma once
 
 #include <string>
-#include <nlohmann/json.hpp>
+#include <vector>
+#include "json_type.hpp"
+#include "document.hpp"
 
 namespace config {
 
-    using json = nlohmann::ordered_json;
-
     // 设置默认配置目录（程序启动时调用一次）
     void set_default_config_dir(const std::string& path);
 
     // 获取默认配置目录（调用前需先调用 set_default_config_dir）
     const std::string& get_default_config_dir();
 
+    // 所有应用配置的根目录（$XDG_CONFIG_HOME、~/.config 或 %APPDATA%），每个应用占一个子目录
+    std::string config_home();
+
     // 根据应用名自动检测默认配置目录（内部辅助函数，一般 main 调用后传入 set_default_config_dir）
     std::string detect_default_config_dir(const std::string& app_name);
 
     // 加载指定路径的配置文件（json格式）
     json load_config(const std::string& path);
 
+    // 加载配置文件到独立内存区的文档（编辑器、批量校验等整体加载、整体释放的场景）
+    document load_config_document(const std::string& path);
+
     // 保存配置到指定路径（json格式）
     void save_config(const std::string& path, const json& config);
 
+    // configs_dir 的 active 指向分层配置的合并结果（configs_dir/.merged/ 中的文件），且 changed_paths 中有它的某一层时，
+    // 原子地重新生成合并结果并返回对应的配置文件路径；无需刷新时返回空字符串，失败时抛异常。
+    // save_config 会自动调用；绕过 save_config 直接写回配置的调用方（如迁移）写完后需自行调用
+    std::string refresh_active_merged(const std::string& configs_dir, const std::vector<std::string>& changed_paths);
+
     // 获取“激活”的配置文件路径（即 active 符号链接指向的文件）
     std::string get_active_config_path();
 
-    // 设置“激活”的配置文件（通过更新 active 符号链接）
+    // 设置“激活”的配置文件（通过原子替换 active 符号链接；分层配置指向合并后的结果）
     void set_active_config(const std::string& config_path);
 
+    // 批量激活中的一项：应用的 configs 目录，以及其中要激活的配置文件
+    struct activation {
+        std::string configs_dir;
+        std::string config_path;
+    };
+
+    // 一次激活多个应用：先为所有应用做好准备（暂存分层配置的合并结果、以临时名创建新链接），
+    // 全部成功后再依次原子替换各自的 active，最后每个目录同步一次。
+    // 准备阶段出错时清理临时链接并抛异常，不激活任何应用
+    void set_active_configs(const std::vector<activation>& items);
+
     // 验证 schema.json 是否存在
     bool has_schema();
 
@@ -0,0 +1,428 @@
+#include "config_index.hpp"
+#include "config_file.hpp"
+#include "document.hpp"
+#include "tree_hash.hpp"
+#include "../utils/fs.hpp"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace config {
+
+    namespace fs = std::filesystem;
+
+    namespace {
+
+        constexpr int index_version = 2;
+
+        std::string escape_token(const std::string& token) {
+            std::string out;
+            for (char c : token) {
+                if (c == '~') out += "~0";
+                else if (c == '/') out += "~1";
+                else out += c;
+            }
+            return out;
+        }
+
+        // 收集所有叶子（非容器）值的路径，值仍留在原文档中
+        void collect_leaves(const json& node, const std::string& pointer,
+                            std::vector<std::pair<std::string, const json*>>& leaves) {
+            if (node.is_object()) {
+                for (auto it = node.begin(); it != node.end(); ++it) {
+                    collect_leaves(it.value(), pointer + "/" + escape_token(it.key()), leaves);
+                }
+            } else if (node.is_array()) {
+                size_t i = 0;
+                for (const auto& item : node) {
+                    collect_leaves(item, pointer + "/" + std::to_string(i++), leaves);
+                }
+            } else {
+                leaves.emplace_back(pointer, &node);
+            }
+        }
+
+        std::string trim(const std::string& s) {
+            size_t begin = s.find_first_not_of(" \t\r\n");
+            if (begin == std::string::npos) return "";
+            size_t end = s.find_last_not_of(" \t\r\n");
+            return s.substr(begin, end - begin + 1);
+        }
+
+        std::string to_lower(std::string s) {
+            for (auto& c : s) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            return s;
+        }
+
+        // 值中的词：完整值本身，以及按非字母数字字符拆分后的片段（如主机名的各段）；
+        // 超过 max_length 字节的不算（建索引时避免把整段证书之类的长值当作词）
+        std::set<std::string> value_tokens(const json& value, size_t max_length = std::string::npos) {
+            std::set<std::string> tokens;
+            std::string text = value.is_string() ? value.get<std::string>() : value.dump();
+            text = to_lower(text);
+            if (text.empty()) return tokens;
+            if (text.size() <= max_length) tokens.insert(text);
+            std::string part;
+            for (char c : text) {
+                if (std::isalnum(static_cast<unsigned char>(c)) || c == '_') {
+                    part += c;
+                } else if (!part.empty()) {
+                    if (part.size() <= max_length) tokens.insert(part);
+                    part.clear();
+                }
+            }
+            if (!part.empty() && part.size() <= max_length) tokens.insert(part);
+            return tokens;
+        }
+
+        std::string hex(uint64_t v) {
+            std::ostringstream oss;
+            oss << std::hex << v;
+            return oss.str();
+        }
+
+        std::string read_file(const std::string& path) {
+            std::ifstream ifs(path, std::ios::binary);
+            if (!ifs.is_open()) {
+                throw std::runtime_error("Cannot open config file: " + path);
+            }
+            std::ostringstream oss;
+            oss << ifs.rdbuf();
+            return oss.str();
+        }
+
+        // 路径模式匹配，* 匹配任意一段
+        bool pointer_matches(const std::string& pattern, const std::string& pointer) {
+            size_t p = 0, q = 0;
+            while (p < pattern.size() && q < pointer.size()) {
+                size_t pe = pattern.find('/', p + 1);
+                size_t qe = pointer.find('/', q + 1);
+                if (pe == std::string::npos) pe = pattern.size();
+                if (qe == std::string::npos) qe = pointer.size();
+                std::string a = pattern.substr(p, pe - p);
+                if (a != "/*" && a != pointer.substr(q, qe - q)) return false;
+                p = pe;
+                q = qe;
+            }
+            return p == pattern.size() && q == pointer.size();
+        }
+
+        bool compare(const json& value, const std::string& op, const std::string& operand) {
+            if (op.empty()) return true;
+            int cmp;
+            if (value.is_number()) {
+                double rhs;
+                try {
+                    rhs = std::stod(operand);
+                } catch (const std::exception&) {
+                    return op == "!=";
+                }
+                double lhs = value.get<double>();
+                cmp = lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+            } else {
+                std::string lhs = value.is_string() ? value.get<std::string>() : value.dump();
+                cmp = lhs.compare(operand);
+                cmp = cmp < 0 ? -1 : (cmp > 0 ? 1 : 0);
+            }
+            if (op == "=") return cmp == 0;
+            if (op == "!=") return cmp != 0;
+            if (op == ">") return cmp > 0;
+            if (op == ">=") return cmp >= 0;
+            if (op == "<") return cmp < 0;
+            if (op == "<=") return cmp <= 0;
+            return false;
+        }
+
+    }  // namespace
+
+    config_index::config_index(const std::string& configs_dir)
+        : configs_dir_(configs_dir),
+          index_path_((fs::path(configs_dir).parent_path() / "index.json").string()) {
+        load();
+    }
+
+    // index.json:
+    //   files:    文件名 -> {id, mtime, size, hash}
+    //   pointers: [[路径, [文件编号...]], ...]，路径编号即数组下标
+    //   tokens:   词 -> [[文件编号, 路径编号], ...]
+    // 文件设置了哪些路径、含有哪些词不单独保存，加载时由 pointers 和 tokens 反推
+    void config_index::load() {
+        files_.clear();
+        file_ids_.clear();
+        pointers_.clear();
+        tokens_.clear();
+
+        std::ifstream ifs(index_path_);
+        if (!ifs.is_open()) return;
+        try {
+            json data;
+            ifs >> data;
+            if (!data.is_object() || data.value("version", 0) != index_version) return;
+
+            for (auto it = data.at("files").begin(); it != data.at("files").end(); ++it) {
+                uint32_t id = it.value().at("id").get<uint32_t>();
+                if (id >= files_.size()) files_.resize(id + 1);
+                auto& file = files_[id];
+                if (!file.name.empty()) throw std::runtime_error("Duplicate file id in index");
+                file.name = it.key();
+                file.mtime = it.value().at("mtime").get<int64_t>();
+                file.size = it.value().at("size").get<uint64_t>();
+                file.hash = it.value().at("hash").get<std::string>();
+                file_ids_[file.name] = id;
+            }
+            auto file_at = [this](const json& id) -> indexed_file& {
+                uint32_t i = id.get<uint32_t>();
+                if (i >= files_.size() || files_[i].name.empty()) throw std::runtime_error("Unknown file id in index");
+                return files_[i];
+            };
+
+            std::vector<std::string> pointer_names;
+            for (const auto& entry : data.at("pointers")) {
+                const std::string& pointer = pointer_names.emplace_back(entry.at(0).get<std::string>());
+                auto& ids = pointers_[pointer];
+                for (const auto& id : entry.at(1)) {
+                    file_at(id).pointers.push_back(pointer);
+                    ids.insert(id.get<uint32_t>());
+                }
+            }
+            for (auto it = data.at("tokens").begin(); it != data.at("tokens").end(); ++it) {
+                auto& postings = tokens_[it.key()];
+                for (const auto& hit : it.value()) {
+                    uint32_t id = hit.at(0).get<uint32_t>();
+                    size_t pointer = hit.at(1).get<size_t>();
+                    if (pointer >= pointer_names.size()) throw std::runtime_error("Unknown pointer id in index");
+                    auto& list = postings[id];
+                    if (list.empty()) file_at(hit.at(0)).tokens.push_back(it.key());
+                    list.push_back(pointer_names[pointer]);
+                }
+            }
+        } catch (const std::exception&) {
+            // 索引损坏时重建
+            files_.clear();
+            file_ids_.clear();
+            pointers_.clear();
+            tokens_.clear();
+        }
+    }
+
+    void config_index::save() const {
+        json data = json::object();
+        data["version"] = index_version;
+
+        json& files = data["files"] = json::object();
+        for (const auto& [name, id] : file_ids_) {
+            const auto& file = files_[id];
+            files[name] = {{"id", id}, {"mtime", file.mtime}, {"size", file.size}, {"hash", file.hash}};
+        }
+
+        std::unordered_map<std::string, uint32_t> pointer_ids;
+        json& pointers = data["pointers"] = json::array();
+        for (const auto& [pointer, ids] : pointers_) {
+            pointer_ids.emplace(pointer, static_cast<uint32_t>(pointers.size()));
+            json list = json::array();
+            for (uint32_t id : ids) list.push_back(id);
+            pointers.push_back(json::array({pointer, std::move(list)}));
+        }
+
+        json& tokens = data["tokens"] = json::object();
+        for (const auto& [token, postings] : tokens_) {
+            json list = json::array();
+            for (const auto& [id, paths] : postings) {
+                for (const auto& pointer : paths) list.push_back(json::array({id, pointer_ids.at(pointer)}));
+            }
+            tokens[token] = std::move(list);
+        }
+
+        // 先写临时文件再 rename：写入中断或并发查询时，读到的索引要么是旧的要么是新的，不会被截断
+        utils::filesystem::write_file_atomic(index_path_, data.dump());
+    }
+
+    void config_index::add_file(const std::string& name, const json& config) {
+        uint32_t id = 0;
+        while (id < files_.size() && !files_[id].name.empty()) ++id;
+        if (id == files_.size()) files_.emplace_back();
+        auto& file = files_[id];
+        file.name = name;
+        file_ids_[name] = id;
+
+        std::vector<std::pair<std::string, const json*>> leaves;
+        collect_leaves(config, "", leaves);
+        for (const auto& [pointer, value] : leaves) {
+            pointers_[pointer].insert(id);
+            file.pointers.push_back(pointer);
+            for (const auto& token : value_tokens(*value, max_token_length)) {
+                auto& list = tokens_[token][id];
+                if (list.empty()) file.tokens.push_back(token);
+                list.push_back(pointer);
+            }
+        }
+    }
+
+    void config_index::remove_file(const std::string& name) {
+        auto found = file_ids_.find(name);
+        if (found == file_ids_.end()) return;
+        uint32_t id = found->second;
+        auto& file = files_[id];
+
+        // 只访问该文件涉及的路径和词，每处按文件编号直接删除，不扫描倒排表
+        for (const auto& pointer : file.pointers) {
+            auto it = pointers_.find(pointer);
+            if (it == pointers_.end()) continue;
+            it->second.erase(id);
+            if (it->second.empty()) pointers_.erase(it);
+        }
+        for (const auto& token : file.tokens) {
+            auto it = tokens_.find(token);
+            if (it == tokens_.end()) continue;
+            it->second.erase(id);
+            if (it->second.empty()) tokens_.erase(it);
+        }
+        file = indexed_file{};
+        file_ids_.erase(found);
+    }
+
+    void config_index::update() {
+        bool changed = false;
+        // 一次扫描得到文件名和元数据，未变化的文件不再单独 stat
+        auto entries = utils::filesystem::scan_json_files(configs_dir_);
+        std::set<std::string> present;
+        for (const auto& entry : entries) present.insert(entry.name);
+
+        // 已删除的文件
+        std::vector<std::string> removed;
+        for (const auto& [name, id] : file_ids_) {
+            if (!present.count(name)) removed.push_back(name);
+        }
+        for (const auto& name : removed) {
+            remove_file(name);
+            changed = true;
+        }
+
+        for (const auto& scanned : entries) {
+            const std::string& name = scanned.name;
+            std::string path = (fs::path(configs_dir_) / name).string();
+            int64_t mtime = scanned.mtime;
+            uint64_t size = scanned.size;
+
+            auto found = file_ids_.find(name);
+            if (found != file_ids_.end() && files_[found->second].mtime == mtime && files_[found->second].size == size) {
+                continue;
+            }
+
+            // mtime 或大小变化：内容哈希相同则只更新元数据，否则重新解析
+            std::string content;
+            try {
+                content = read_file(path);
+            } catch (const std::exception&) {
+                // 扫描之后文件被删除或改名：按已删除处理，下次扫描到时再加入
+                if (found != file_ids_.end()) {
+                    remove_file(name);
+                    changed = true;
+                }
+                continue;
+            }
+            std::string hash = hex(hash_bytes(content));
+            if (found == file_ids_.end() || files_[found->second].hash != hash) {
+                // 解析结果只用于提取叶子，放在临时内存区中，处理完整体释放
+                document doc;
+                try {
+                    doc = document::parse(content);
+                } catch (const std::exception&) {
+                    doc.root() = json::object();  // 无法解析的文件不参与索引
+                }
+                remove_file(name);
+                add_file(name, doc.root());
+            }
+            auto& file = files_[file_ids_.at(name)];
+            file.mtime = mtime;
+            file.size = size;
+            file.hash = hash;
+            changed = true;
+        }
+
+        if (changed) save();
+    }
+
+    std::vector<index_hit> config_index::query(const std::string& text) const {
+        // 候选的 (文件, 路径)，确定后再读取这些文件取值
+        std::map<std::string, std::vector<std::string>> candidates;
+        std::function<bool(const json&)> accept;
+        // 运算符两侧和整个表达式首尾的空白都忽略："/db/pool_size > 64" 与 "/db/pool_size>64" 相同
+        const std::string expression = trim(text);
+
+        if (!expression.empty() && expression[0] == '/') {
+            // 路径查询，可带比较运算符
+            size_t op_pos = expression.find_first_of("=!<>");
+            std::string pattern = trim(expression.substr(0, op_pos));
+            std::string op, operand;
+            if (op_pos != std::string::npos) {
+                size_t operand_pos = expression.find_first_not_of("=!<>", op_pos);
+                if (operand_pos == std::string::npos) operand_pos = expression.size();
+                op = expression.substr(op_pos, operand_pos - op_pos);
+                operand = trim(expression.substr(operand_pos));
+            }
+
+            auto add = [&](const std::string& pointer, const std::set<uint32_t>& ids) {
+                for (uint32_t id : ids) candidates[files_[id].name].push_back(pointer);
+            };
+            if (pattern.find('*') == std::string::npos) {
+                auto it = pointers_.find(pattern);
+                if (it != pointers_.end()) add(pattern, it->second);
+            } else {
+                for (const auto& [pointer, ids] : pointers_) {
+                    if (pointer_matches(pattern, pointer)) add(pointer, ids);
+                }
+            }
+            accept = [op, operand](const json& value) { return compare(value, op, operand); };
+        } else {
+            // 词查询：取第一个可索引的词的倒排表，再按值检查所有词
+            std::istringstream iss(to_lower(expression));
+            std::vector<std::string> words;
+            for (std::string w; iss >> w;) words.push_back(w);
+            auto key = std::find_if(words.begin(), words.end(),
+                                    [](const std::string& w) { return w.size() <= max_token_length; });
+            if (key == words.end()) return {};
+
+            auto it = tokens_.find(*key);
+            if (it == tokens_.end()) return {};
+            for (const auto& [id, paths] : it->second) {
+                auto& list = candidates[files_[id].name];
+                list.insert(list.end(), paths.begin(), paths.end());
+            }
+            accept = [words](const json& value) {
+                auto value_words = value_tokens(value);
+                return std::all_of(words.begin(), words.end(),
+                                   [&](const std::string& w) { return value_words.count(w) > 0; });
+            };
+        }
+
+        // 每个命中的文件只读取、解析一次；文件已不存在、无法解析或不再含有该路径时跳过
+        std::vector<index_hit> hits;
+        for (const auto& [name, paths] : candidates) {
+            document doc;
+            try {
+                doc = document::parse(read_file((fs::path(configs_dir_) / name).string()));
+            } catch (const std::exception&) {
+                continue;
+            }
+            for (const auto& pointer : paths) {
+                json::json_pointer ptr(pointer);
+                if (!doc.root().contains(ptr)) continue;
+                json value = doc.root().at(ptr);  // 复制到堆上，随 doc 释放的内存区不再被引用
+                if (accept(value)) hits.push_back({name, pointer, std::move(value)});
+            }
+        }
+
+        std::sort(hits.begin(), hits.end(), [](const index_hit& a, const index_hit& b) {
+            return a.file != b.file ? a.file < b.file : a.pointer < b.pointer;
+        });
+        return hits;
+    }
+
+}  // namespace config
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "json_type.hpp"
+
+namespace config {
+
+    // 查询命中：某个配置文件在某个路径上设置的值
+    struct index_hit {
+        std::string file;
+        std::string pointer;
+        json value;
+    };
+
+    // 跨配置的倒排索引，保存在应用目录下的 index.json（与 schema.json 同级）
+    //   pointers: JSON Pointer -> 设置了该路径的配置文件
+    //   tokens:   值中的词 -> (配置文件, JSON Pointer)
+    // 索引只记录文件、路径和词的编号，不保存值本身；查询时只读取命中的配置文件取值。
+    // 超过 max_token_length 字节的值和片段不建立词条（如证书、密钥），词查询中至少要有一个词不超过该长度。
+    // 每个文件记录 mtime、大小和内容哈希，update() 只重新解析发生变化的文件。
+    // 索引的是文件自身设置的值（分层配置不展开基础配置）。
+    class config_index {
+    public:
+        static constexpr size_t max_token_length = 64;
+
+        explicit config_index(const std::string& configs_dir);
+
+        // 扫描配置目录，增量更新索引；有变化时写回磁盘
+        void update();
+
+        // 查询表达式：
+        //   /db/pool_size          设置了该路径的配置
+        //   /db/pool_size>64       比较，支持 = != > >= < <=（数值按数值比较，否则按字符串）
+        //   /servers/*/host=a.com  路径中 * 匹配任意一段
+        //   example.com            值中包含该词的配置和路径（多个词以空格分隔，需同时出现在同一个值中）
+        std::vector<index_hit> query(const std::string& expression) const;
+
+        const std::string& index_path() const { return index_path_; }
+
+    private:
+        // 索引中的一个配置文件，编号是它在 files_ 中的下标；删除后空出的编号留给新文件
+        struct indexed_file {
+            std::string name;                   // 空表示该编号空闲
+            int64_t mtime = 0;
+            uint64_t size = 0;
+            std::string hash;
+            std::vector<std::string> pointers;  // 文件设置的路径
+            std::vector<std::string> tokens;    // 文件的值中出现的词，删除文件时据此清理倒排表
+        };
+
+        void load();
+        void save() const;
+        void add_file(const std::string& name, const json& config);
+        void remove_file(const std::string& name);
+
+        std::string configs_dir_;
+        std::string index_path_;
+        std::vector<indexed_file> files_;
+        std::map<std::string, uint32_t> file_ids_;
+        std::map<std::string, std::set<uint32_t>> pointers_;                          // 路径 -> 文件编号
+        std::map<std::string, std::map<uint32_t, std::vector<std::string>>> tokens_;  // 词 -> 文件编号 -> 路径
+    };
+
+}  // namespace config
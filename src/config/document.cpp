@@ -0,0 +1,28 @@
+#include "document.hpp"
+
+namespace config {
+
+    document::document() : arena_(std::make_unique<arena>()) {}
+
+    document::~document() = default;
+
+    document::document(document&& other) noexcept
+        : arena_(std::move(other.arena_)), root_(std::move(other.root_)) {}
+
+    document& document::operator=(document&& other) noexcept {
+        // 先交换内容（旧内容在这里析构），再替换内存区
+        root_ = std::move(other.root_);
+        arena_ = std::move(other.arena_);
+        return *this;
+    }
+
+    document document::parse(const std::string& text) {
+        document doc;
+        // 按文本长度估计首块大小，大多数文档只需一两个内存块
+        doc.arena_ = std::make_unique<arena>(text.size() * 2);
+        arena_scope scope(*doc.arena_);
+        doc.root_ = json::parse(text);
+        return doc;
+    }
+
+}  // namespace config
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include "json_type.hpp"
+
+namespace config {
+
+    // 独占一块内存区的配置文档
+    // 解析时节点、对象和数组的存储从内存区分配，释放时不再逐个 free，而是随内存区整块归还。
+    // 字符串内容（std::string）和大对象的哈希索引仍在堆上，所以文档析构时仍要遍历整棵树、
+    // 逐个释放这些堆内存；省下的是节点和容器存储的分配与释放，并非 O(1) 释放。
+    // 之后对 root() 的修改照常从堆分配，可以任意编辑。
+    // 注意：不要把 root() 中的子树 std::move 到文档之外，移出的节点仍指向本文档的内存区；需要时应复制。
+    // 调试构建中，文档析构时若仍有这样的节点存活会触发断言。
+    class document {
+    public:
+        document();
+        ~document();
+
+        document(document&& other) noexcept;
+        document& operator=(document&& other) noexcept;
+
+        document(const document&) = delete;
+        document& operator=(const document&) = delete;
+
+        // 解析 JSON 文本，失败时抛出 nlohmann 的 parse_error
+        static document parse(const std::string& text);
+
+        json& root() { return root_; }
+        const json& root() const { return root_; }
+
+        // 内存区已分配的字节数
+        size_t arena_bytes() const { return arena_ ? arena_->bytes_used() : 0; }
+
+    private:
+        std::unique_ptr<arena> arena_;  // 必须先于 root_ 声明：root_ 先析构，内存区后释放
+        json root_;
+    };
+
+}  // namespace config
@@ -0,0 +1,260 @@
+#include "history.hpp"
+#include "config_file.hpp"
+#include "../utils/fs.hpp"
+#include "../utils/sha256.hpp"
+#include "../utils/trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace config {
+
+    namespace fs = std::filesystem;
+
+    namespace {
+
+        // 序列化后小于该长度的对象或数组内联在父对象中，不单独成为对象
+        constexpr size_t inline_limit = 64;
+
+        // 成员数超过该值的对象或数组分块存储
+        constexpr size_t fanout = 32;
+
+        // 先写临时文件再改名，进程中断时不会留下写了一半的对象
+        // 临时文件名带进程号和序号（write_file_atomic），编辑器与同时运行的 --activate、--migrate
+        // 写同一个历史目录时不会互相覆盖对方的临时文件
+        void write_file(const fs::path& path, const std::string& content) {
+            fs::create_directories(path.parent_path());
+            utils::filesystem::write_file_atomic(path.string(), content);
+        }
+
+        json to_json(const version_entry& entry) {
+            json j = {{"seq", entry.seq}, {"time", entry.time}, {"event", entry.event},
+                      {"file", entry.file}, {"root", entry.root}};
+            if (!entry.snapshot.empty()) j["snapshot"] = entry.snapshot;
+            return j;
+        }
+
+    }  // namespace
+
+    version_store::version_store(const std::string& app_dir)
+        : dir_((fs::path(app_dir) / "history").string()) {}
+
+    std::string version_store::object_path(const std::string& hash) const {
+        return (fs::path(dir_) / "objects" / hash.substr(0, 2) / hash.substr(2)).string();
+    }
+
+    // 子节点先写入，再由子节点的哈希组成本节点的对象，形成 Merkle 树。
+    // 返回本节点的对象哈希；节点太小而内联时返回空串，内联值放在 inline_value
+    std::string version_store::store_node(const json& node, json& inline_value, bool force) {
+        if (!node.is_structured()) {
+            inline_value = node;
+            return "";
+        }
+
+        // 每个成员：键（数组为下标）、内联值或子对象哈希
+        struct member {
+            std::string key;
+            json value;
+            std::string hash;
+        };
+        std::vector<member> members;
+        members.reserve(node.size());
+        size_t index = 0;
+        for (auto it = node.begin(); it != node.end(); ++it, ++index) {
+            member m;
+            m.key = node.is_object() ? it.key() : std::to_string(index);
+            m.hash = store_node(it.value(), m.value, false);
+            members.push_back(std::move(m));
+        }
+
+        // 成员 [first, last) 组成的对象：{"node": 内联部分, "refs": 键 -> 子对象哈希}
+        auto encode = [&](size_t first, size_t last) {
+            json body = node.is_object() ? json::object() : json::array();
+            json refs = json::object();
+            for (size_t i = first; i < last; ++i) {
+                auto& m = members[i];
+                if (!m.hash.empty()) refs[node.is_object() ? m.key : std::to_string(i - first)] = m.hash;
+                if (node.is_object()) {
+                    body[m.key] = std::move(m.value);
+                } else {
+                    body.push_back(std::move(m.value));
+                }
+            }
+            return json{{"node", std::move(body)}, {"refs", std::move(refs)}};
+        };
+
+        // 成员很多时按 fanout 分块，每块单独成为对象：修改一个成员只产生一个新块和一个很小的块列表
+        std::string text;
+        if (members.size() > fanout) {
+            json chunks = json::array();
+            for (size_t first = 0; first < members.size(); first += fanout) {
+                chunks.push_back(put_object(encode(first, std::min(first + fanout, members.size())).dump()));
+            }
+            text = json{{"array", node.is_array()}, {"chunks", std::move(chunks)}}.dump();
+        } else {
+            json object = encode(0, members.size());
+            text = object.dump();
+            if (!force && object["refs"].empty() && text.size() < inline_limit) {
+                inline_value = std::move(object["node"]);
+                return "";
+            }
+        }
+        return put_object(text);
+    }
+
+    std::string version_store::put_object(const std::string& text) {
+        // 对象按 SHA-256 寻址：已登记或已存在的同名对象即视为内容相同，不再读回比较
+        std::string hash = utils::sha256_hex(text);
+        if (!known_.count(hash)) {
+            fs::path path = object_path(hash);
+            if (!fs::exists(path)) write_file(path, text);
+            known_.insert(hash);
+        }
+        return hash;
+    }
+
+    std::string version_store::put(const json& config) {
+        TRACE_SCOPE("history_put", "config", dir_);
+        // 首次写入前登记已有对象，之后未变化的子树既不写文件也不检查文件
+        if (!scanned_) {
+            std::error_code ec;
+            for (const auto& entry : fs::recursive_directory_iterator(fs::path(dir_) / "objects", ec)) {
+                // 跳过写入中断残留的临时文件（<对象名>.tmp-<进程号>-<序号>）
+                if (!entry.is_regular_file(ec) || entry.path().filename().string().find(".tmp") != std::string::npos) continue;
+                known_.insert(entry.path().parent_path().filename().string() + entry.path().filename().string());
+            }
+            scanned_ = true;
+        }
+        json unused;
+        return store_node(config, unused, true);
+    }
+
+    json version_store::get(const std::string& root) const {
+        std::ifstream ifs(object_path(root));
+        if (!ifs.is_open()) {
+            throw std::runtime_error("Cannot open history object: " + root);
+        }
+        json object;
+        try {
+            ifs >> object;
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Failed to parse history object " + root + ": " + e.what());
+        }
+
+        if (object.contains("chunks")) {
+            json node = object["array"].get<bool>() ? json::array() : json::object();
+            for (const auto& chunk : object["chunks"]) {
+                json part = get(chunk.get<std::string>());
+                if (node.is_array()) {
+                    for (auto& item : part) node.push_back(std::move(item));
+                } else {
+                    for (auto it = part.begin(); it != part.end(); ++it) node[it.key()] = std::move(it.value());
+                }
+            }
+            return node;
+        }
+
+        json node = std::move(object["node"]);
+        for (auto it = object["refs"].begin(); it != object["refs"].end(); ++it) {
+            json child = get(it.value().get<std::string>());
+            if (node.is_array()) {
+                node[std::stoul(it.key())] = std::move(child);
+            } else {
+                node[it.key()] = std::move(child);
+            }
+        }
+        return node;
+    }
+
+    std::string version_store::materialize(const std::string& root, const std::string& file) {
+        fs::path path = fs::path(dir_) / "snapshots" / root / file;
+        if (!fs::exists(path)) {
+            write_file(path, get(root).dump(4));
+        }
+        return path.string();
+    }
+
+    void version_store::append(version_entry& entry) {
+        fs::create_directories(dir_);
+        if (next_seq_ == 0) {
+            auto entries = list();
+            next_seq_ = entries.empty() ? 1 : entries.back().seq + 1;
+        }
+        entry.seq = next_seq_++;
+        entry.time = std::chrono::duration_cast<std::chrono::seconds>(
+                         std::chrono::system_clock::now().time_since_epoch()).count();
+        std::ofstream ofs(fs::path(dir_) / "log.jsonl", std::ios::app);
+        if (!ofs.is_open()) {
+            throw std::runtime_error("Cannot open history log: " + (fs::path(dir_) / "log.jsonl").string());
+        }
+        ofs << to_json(entry).dump() << "\n";
+    }
+
+    version_entry version_store::record(const std::string& event, const std::string& file, const json& config) {
+        version_entry entry;
+        entry.event = event;
+        entry.file = file;
+        entry.root = put(config);
+        if (event != "save") {
+            entry.snapshot = materialize(entry.root, file);
+        }
+        append(entry);
+        return entry;
+    }
+
+    std::vector<version_entry> version_store::list() const {
+        std::vector<version_entry> entries;
+        std::ifstream ifs(fs::path(dir_) / "log.jsonl");
+        for (std::string line; std::getline(ifs, line);) {
+            try {
+                json j = json::parse(line);
+                version_entry entry;
+                entry.seq = j.at("seq").get<uint64_t>();
+                entry.time = j.at("time").get<int64_t>();
+                entry.event = j.at("event").get<std::string>();
+                entry.file = j.at("file").get<std::string>();
+                entry.root = j.at("root").get<std::string>();
+                entry.snapshot = j.value("snapshot", std::string());
+                entries.push_back(std::move(entry));
+            } catch (const std::exception&) {
+                // 跳过写了一半或损坏的行
+            }
+        }
+        return entries;
+    }
+
+    void version_store::rollback(const version_entry& entry, const std::string& active_link) {
+        std::string target = entry.snapshot.empty() || !fs::exists(entry.snapshot)
+                                 ? materialize(entry.root, entry.file)
+                                 : entry.snapshot;
+        if (!utils::filesystem::create_symlink(target, active_link)) {
+            throw std::runtime_error("Failed to create symlink: " + active_link + " -> " + target);
+        }
+
+        version_entry rolled;
+        rolled.event = "rollback";
+        rolled.file = entry.file;
+        rolled.root = entry.root;
+        rolled.snapshot = target;
+        append(rolled);
+    }
+
+    version_store& version_store_for(const std::string& app_dir) {
+        static std::mutex stores_mutex;
+        static std::map<std::string, std::unique_ptr<version_store>> stores;
+        std::lock_guard<std::mutex> lock(stores_mutex);
+        auto& store = stores[app_dir];
+        if (!store) store = std::make_unique<version_store>(app_dir);
+        return *store;
+    }
+
+    version_store& default_version_store() {
+        return version_store_for(fs::path(get_default_config_dir()).parent_path().string());
+    }
+
+}  // namespace config
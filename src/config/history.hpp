@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "json_type.hpp"
+
+namespace config {
+
+    // 一条历史记录：一次保存或激活
+    struct version_entry {
+        uint64_t seq = 0;       // 序号，从 1 开始
+        int64_t time = 0;       // Unix 时间（秒）
+        std::string event;      // "save" / "activate" / "rollback"
+        std::string file;       // 配置文件名
+        std::string root;       // 内容的根对象哈希
+        std::string snapshot;   // 已物化的完整文件（激活和回滚记录才有），回滚时 active 直接指向它
+    };
+
+    // 应用目录下的版本历史（history/）
+    //   objects/xx/yyyy...  按 SHA-256 内容寻址的对象：每个较大的对象或数组单独存为一个对象（成员很多时再分块），
+    //                       子对象只记录哈希，相同的子树在所有版本之间只存一份
+    //   snapshots/<根哈希>/<文件名>  激活过的版本物化后的完整文件
+    //   log.jsonl           每行一条 version_entry，列出历史只读这个文件
+    class version_store {
+    public:
+        explicit version_store(const std::string& app_dir);
+
+        // 写入配置内容（已存在的对象不再写），返回根对象哈希
+        std::string put(const json& config);
+
+        // 按根对象哈希还原完整配置
+        json get(const std::string& root) const;
+
+        // 将指定版本物化为完整文件（已物化时直接返回），返回文件路径
+        std::string materialize(const std::string& root, const std::string& file);
+
+        // 记录一次保存或激活；激活记录同时物化快照
+        version_entry record(const std::string& event, const std::string& file, const json& config);
+
+        // 全部历史，按时间先后
+        std::vector<version_entry> list() const;
+
+        // 把 active 符号链接改指向该版本的快照（未物化的版本先物化），并记一条回滚记录
+        void rollback(const version_entry& entry, const std::string& active_link);
+
+        const std::string& dir() const { return dir_; }
+
+    private:
+        std::string store_node(const json& node, json& inline_value, bool force);
+        std::string put_object(const std::string& text);
+        std::string object_path(const std::string& hash) const;
+        void append(version_entry& entry);
+
+        std::string dir_;
+        std::unordered_set<std::string> known_;  // 已确认存在的对象，避免每次保存逐个检查文件
+        bool scanned_ = false;
+        uint64_t next_seq_ = 0;  // 首次追加时从日志读取
+    };
+
+    // 指定应用目录的版本历史（同一目录在进程内共用一个实例）
+    version_store& version_store_for(const std::string& app_dir);
+
+    // 默认配置目录所属应用的版本历史（save_config / set_active_config 自动记录到这里）
+    version_store& default_version_store();
+
+}  // namespace config
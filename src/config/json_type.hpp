@@ -0,0 +1,210 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+#include "arena.hpp"
+
+namespace config {
+
+    // 带哈希索引的有序对象
+    // 存储和迭代顺序与 nlohmann::ordered_map 完全一致（按插入顺序的 vector），dump() 输出不变；
+    // 键数达到 index_threshold 后额外维护 键 -> 下标 的哈希索引，find / contains / operator[] / at 为 O(1)。
+    // 小对象不建索引，线性查找更快也更省内存。
+    template <class Key, class T, class IgnoredLess = std::less<Key>,
+              class Allocator = std::allocator<std::pair<const Key, T>>>
+    class indexed_map : public nlohmann::ordered_map<Key, T, IgnoredLess, Allocator> {
+        using base = nlohmann::ordered_map<Key, T, IgnoredLess, Allocator>;
+
+    public:
+        using typename base::Container;
+        using typename base::key_type;
+        using typename base::mapped_type;
+        using typename base::iterator;
+        using typename base::const_iterator;
+        using typename base::size_type;
+        using typename base::value_type;
+        using typename base::key_compare;
+
+        static constexpr size_type index_threshold = 16;
+
+        indexed_map() noexcept(noexcept(base())) : base() {}
+        explicit indexed_map(const Allocator& alloc) : base(alloc) {}
+
+        template <class It>
+        indexed_map(It first, It last, const Allocator& alloc = Allocator()) : base(alloc) {
+            insert(first, last);
+        }
+
+        indexed_map(std::initializer_list<value_type> init, const Allocator& alloc = Allocator()) : base(alloc) {
+            insert(init.begin(), init.end());
+        }
+
+        template <class KeyType>
+        std::pair<iterator, bool> emplace(KeyType&& key, T&& t) {
+            size_type pos = position(key);
+            if (pos != npos) return {this->begin() + pos, false};
+            grow_if_full();
+            Container::emplace_back(std::forward<KeyType>(key), std::forward<T>(t));
+            appended();
+            return {std::prev(this->end()), true};
+        }
+
+        template <class KeyType>
+        T& operator[](KeyType&& key) {
+            return emplace(std::forward<KeyType>(key), T{}).first->second;
+        }
+
+        template <class KeyType>
+        const T& operator[](KeyType&& key) const {
+            return at(key);
+        }
+
+        template <class KeyType>
+        T& at(const KeyType& key) {
+            size_type pos = position(key);
+            if (pos == npos) throw std::out_of_range("key not found");
+            return (this->begin() + pos)->second;
+        }
+
+        template <class KeyType>
+        const T& at(const KeyType& key) const {
+            size_type pos = position(key);
+            if (pos == npos) throw std::out_of_range("key not found");
+            return (this->begin() + pos)->second;
+        }
+
+        template <class KeyType>
+        iterator find(const KeyType& key) {
+            size_type pos = position(key);
+            return pos == npos ? this->end() : this->begin() + pos;
+        }
+
+        template <class KeyType>
+        const_iterator find(const KeyType& key) const {
+            size_type pos = position(key);
+            return pos == npos ? this->end() : this->begin() + pos;
+        }
+
+        template <class KeyType>
+        size_type count(const KeyType& key) const {
+            return position(key) == npos ? 0 : 1;
+        }
+
+        // 键删除：后续元素前移，索引中它们的下标随之减一
+        template <class KeyType, std::enable_if_t<!std::is_convertible_v<KeyType, const_iterator>, int> = 0>
+        size_type erase(const KeyType& key) {
+            size_type pos = position(key);
+            if (pos == npos) return 0;
+            erase(this->begin() + pos);
+            return 1;
+        }
+
+        iterator erase(iterator pos) {
+            return erase(pos, std::next(pos));
+        }
+
+        iterator erase(iterator first, iterator last) {
+            size_type offset = static_cast<size_type>(std::distance(this->begin(), first));
+            size_type removed = static_cast<size_type>(std::distance(first, last));
+            if (indexed_) {
+                for (auto it = first; it != last; ++it) index_.erase(it->first);
+            }
+            auto result = base::erase(first, last);
+            if (indexed_) {
+                if (this->size() < index_threshold) {
+                    drop_index();
+                } else {
+                    for (auto& entry : index_) {
+                        if (entry.second > offset) entry.second -= removed;
+                    }
+                }
+            }
+            return result;
+        }
+
+        std::pair<iterator, bool> insert(value_type&& value) {
+            return emplace(value.first, std::move(value.second));
+        }
+
+        std::pair<iterator, bool> insert(const value_type& value) {
+            size_type pos = position(value.first);
+            if (pos != npos) return {this->begin() + pos, false};
+            grow_if_full();
+            Container::push_back(value);
+            appended();
+            return {std::prev(this->end()), true};
+        }
+
+        template <typename InputIt, typename = typename base::template require_input_iter<InputIt>>
+        void insert(InputIt first, InputIt last) {
+            for (auto it = first; it != last; ++it) insert(*it);
+        }
+
+        void clear() noexcept {
+            Container::clear();
+            drop_index();
+        }
+
+    private:
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        struct key_hash {
+            using is_transparent = void;
+            size_t operator()(std::string_view key) const { return std::hash<std::string_view>{}(key); }
+        };
+
+        template <class KeyType>
+        size_type position(const KeyType& key) const {
+            if (indexed_) {
+                auto it = index_.find(std::string_view(key));
+                return it == index_.end() ? npos : it->second;
+            }
+            size_type pos = 0;
+            for (auto it = this->begin(); it != this->end(); ++it, ++pos) {
+                if (it->first == key) return pos;
+            }
+            return npos;
+        }
+
+        // pair<const Key, T> 的移动构造不是 noexcept（键只能复制），vector 扩容时会深拷贝所有值。
+        // 这里自行扩容：复制键、移动值，值的子树不再被复制
+        void grow_if_full() {
+            if (this->size() < this->capacity()) return;
+            Container grown(this->get_allocator());
+            grown.reserve(this->capacity() == 0 ? 1 : this->capacity() * 2);
+            for (auto& entry : *this) grown.emplace_back(entry.first, std::move(entry.second));
+            Container::swap(grown);
+        }
+
+        // 末尾追加了一个新键
+        void appended() {
+            if (indexed_) {
+                index_.emplace(this->back().first, this->size() - 1);
+            } else if (this->size() >= index_threshold) {
+                index_.reserve(this->size() * 2);
+                size_type pos = 0;
+                for (auto it = this->begin(); it != this->end(); ++it) index_.emplace(it->first, pos++);
+                indexed_ = true;
+            }
+        }
+
+        void drop_index() {
+            index_ = {};
+            indexed_ = false;
+        }
+
+        std::unordered_map<Key, size_type, key_hash, std::equal_to<>> index_;
+        bool indexed_ = false;
+    };
+
+    // 配置与 schema 使用的 json 类型：保持键的插入顺序，大对象的键查找为 O(1)；
+    // 节点、对象和数组的存储经 arena_allocator 分配，可放进 document 的内存区
+    using json = nlohmann::basic_json<indexed_map, std::vector, std::string, bool, std::int64_t, std::uint64_t,
+                                      double, arena_allocator>;
+
+}  // namespace config
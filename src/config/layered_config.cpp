@@ -0,0 +1,265 @@
+#include "layered_config.hpp"
+#include "config_file.hpp"
+#include "../utils/fs.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+namespace config {
+
+    namespace fs = std::filesystem;
+
+    namespace {
+
+        const char* const base_key = "$base";
+        const char* const overlays_key = "$overlays";
+
+        struct layer {
+            std::string path;
+            fs::file_time_type mtime;
+            uintmax_t size = 0;
+            json patch;
+        };
+
+        // 单个分层配置的缓存视图
+        struct layered_view {
+            std::vector<layer> layers;  // 依次为 base、overlays...、文件自身
+            json merged;
+        };
+
+        std::mutex cache_mutex;
+        std::map<std::string, layered_view> cache;
+
+        bool is_stale(const layer& l) {
+            std::error_code ec;
+            auto mtime = fs::last_write_time(l.path, ec);
+            if (ec) return true;
+            auto size = fs::file_size(l.path, ec);
+            return ec || mtime != l.mtime || size != l.size;
+        }
+
+        layer read_layer(const std::string& path) {
+            layer l;
+            l.path = path;
+            std::error_code ec;
+            l.mtime = fs::last_write_time(path, ec);
+            l.size = fs::file_size(path, ec);
+            l.patch = load_config(path);
+            if (!l.patch.is_object()) {
+                throw std::runtime_error("Config layer must be a JSON object: " + path);
+            }
+            return l;
+        }
+
+        // 文件自身声明的层路径（不含自身）
+        std::vector<std::string> declared_layers(const std::string& path, const json& self) {
+            std::vector<std::string> paths;
+            fs::path dir = fs::path(path).parent_path();
+            if (self.contains(base_key)) {
+                paths.push_back((dir / self[base_key].get<std::string>()).string());
+            }
+            if (self.contains(overlays_key)) {
+                for (const auto& overlay : self[overlays_key]) {
+                    paths.push_back((dir / overlay.get<std::string>()).string());
+                }
+            }
+            return paths;
+        }
+
+        // 自身这一层去掉分层声明字段
+        void strip_declarations(json& self) {
+            self.erase(base_key);
+            self.erase(overlays_key);
+        }
+
+        // 按顺序合并所有层在顶层键 key 上的值
+        void merge_key(layered_view& view, const std::string& key) {
+            json value;
+            bool present = false;
+            for (const auto& l : view.layers) {
+                auto it = l.patch.find(key);
+                if (it == l.patch.end()) continue;
+                if (it->is_null()) {
+                    value = nullptr;
+                    present = false;
+                } else {
+                    if (!present) value = nullptr;
+                    value.merge_patch(*it);
+                    present = true;
+                }
+            }
+            if (present) {
+                view.merged[key] = std::move(value);
+            } else {
+                view.merged.erase(key);
+            }
+        }
+
+        // merge_all 得到的顶层键顺序：依次应用各层，新键追加到末尾，null 删除键（之后再出现时重新追加）
+        std::vector<std::string> merged_key_order(const layered_view& view) {
+            std::vector<std::string> order;
+            std::set<std::string> present;
+            for (const auto& l : view.layers) {
+                for (auto it = l.patch.begin(); it != l.patch.end(); ++it) {
+                    if (it->is_null()) {
+                        if (present.erase(it.key())) order.erase(std::find(order.begin(), order.end(), it.key()));
+                    } else if (present.insert(it.key()).second) {
+                        order.push_back(it.key());
+                    }
+                }
+            }
+            return order;
+        }
+
+        // merge_key 只替换值，新增的键追加在末尾；按 merge_all 的顺序重排顶层键，保证两者结果（含键序）一致
+        void restore_key_order(layered_view& view) {
+            auto order = merged_key_order(view);
+            bool same = order.size() == view.merged.size();
+            auto it = view.merged.begin();
+            for (size_t i = 0; same && i < order.size(); ++i, ++it) same = it.key() == order[i];
+            if (same) return;
+            json reordered = json::object();
+            for (const auto& key : order) reordered[key] = std::move(view.merged[key]);
+            view.merged = std::move(reordered);
+        }
+
+        void merge_all(layered_view& view) {
+            view.merged = json::object();
+            for (const auto& l : view.layers) {
+                view.merged.merge_patch(l.patch);
+            }
+        }
+
+        void build(layered_view& view, const std::string& path, layer self) {
+            auto paths = declared_layers(path, self.patch);
+            strip_declarations(self.patch);
+
+            view.layers.clear();
+            for (const auto& p : paths) {
+                layer l = read_layer(p);
+                if (is_layered(l.patch)) {
+                    throw std::runtime_error("Nested config layers are not supported: " + p);
+                }
+                view.layers.push_back(std::move(l));
+            }
+            view.layers.push_back(std::move(self));
+            merge_all(view);
+        }
+
+        // 检查各层是否变化，只重算变化层涉及的顶层键
+        void refresh(layered_view& view, const std::string& path) {
+            std::set<std::string> touched;
+            auto touch = [&touched](const layer& l) {
+                for (auto it = l.patch.begin(); it != l.patch.end(); ++it) touched.insert(it.key());
+            };
+
+            layer& self_layer = view.layers.back();
+            if (is_stale(self_layer)) {
+                layer self = read_layer(path);
+                std::vector<std::string> old_paths;
+                for (size_t i = 0; i + 1 < view.layers.size(); ++i) old_paths.push_back(view.layers[i].path);
+                if (declared_layers(path, self.patch) != old_paths) {
+                    build(view, path, std::move(self));
+                    return;
+                }
+                strip_declarations(self.patch);
+                touch(self_layer);
+                touch(self);
+                self_layer = std::move(self);
+            }
+
+            for (auto& l : view.layers) {
+                if (&l == &self_layer || !is_stale(l)) continue;
+                touch(l);
+                l = read_layer(l.path);
+                if (is_layered(l.patch)) {
+                    throw std::runtime_error("Nested config layers are not supported: " + l.path);
+                }
+                touch(l);
+            }
+            for (const auto& key : touched) {
+                merge_key(view, key);
+            }
+            if (!touched.empty()) restore_key_order(view);
+        }
+
+    }  // namespace
+
+    bool is_layered(const json& config) {
+        return config.is_object() && (config.contains(base_key) || config.contains(overlays_key));
+    }
+
+    json load_merged_config(const std::string& path) {
+        std::string key = fs::absolute(path).lexically_normal().string();
+
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto it = cache.find(key);
+        if (it != cache.end()) {
+            refresh(it->second, path);
+            return it->second.merged;
+        }
+
+        layer self = read_layer(path);
+        if (!is_layered(self.patch)) {
+            return std::move(self.patch);
+        }
+
+        layered_view view;
+        build(view, path, std::move(self));
+        json merged = view.merged;
+        cache.emplace(key, std::move(view));
+        return merged;
+    }
+
+    json merge_layers(const std::string& path, const json& self,
+                      const std::function<json(const std::string&)>& layer_content) {
+        json merged = json::object();
+        for (const auto& p : declared_layers(path, self)) {
+            json patch = layer_content(p);
+            if (!patch.is_object()) {
+                throw std::runtime_error("Config layer must be a JSON object: " + p);
+            }
+            if (is_layered(patch)) {
+                throw std::runtime_error("Nested config layers are not supported: " + p);
+            }
+            merged.merge_patch(patch);
+        }
+        json own = self;
+        strip_declarations(own);
+        merged.merge_patch(own);
+        return merged;
+    }
+
+    std::vector<std::string> config_layer_paths(const std::string& path) {
+        json self = load_config(path);
+        std::vector<std::string> paths;
+        if (is_layered(self)) paths = declared_layers(path, self);
+        paths.push_back(path);
+        return paths;
+    }
+
+    staged_merged_config stage_merged_config(const std::string& path) {
+        staged_merged_config result;
+        result.content = load_merged_config(path);
+        fs::path dir = fs::path(path).parent_path() / ".merged";
+        try {
+            fs::create_directories(dir);
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Failed to create merged config dir: " + dir.string() + ", error: " + e.what());
+        }
+        result.target = (dir / fs::path(path).filename()).string();
+        result.staged = utils::filesystem::stage_file(result.target, result.content.dump(4));
+        return result;
+    }
+
+    std::string materialize_merged_config(const std::string& path) {
+        staged_merged_config merged = stage_merged_config(path);
+        utils::filesystem::commit_file(merged.staged, merged.target);
+        return merged.target;
+    }
+
+}  // namespace config
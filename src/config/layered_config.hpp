@@ -0,0 +1,44 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "json_type.hpp"
+
+namespace config {
+
+    // 分层配置：配置文件可通过以下字段声明基础配置和覆盖层
+    //   "$base": "base.json"                基础配置
+    //   "$overlays": ["a.json", "b.json"]   依次叠加的覆盖层
+    // 文件自身的其余内容作为最后一层。各层按 JSON Merge Patch (RFC 7396) 合并，
+    // 路径相对于该配置文件所在目录。基础配置和覆盖层本身不能再声明分层。
+
+    // 判断配置是否声明了 $base 或 $overlays
+    bool is_layered(const json& config);
+
+    // 加载合并后的配置（非分层配置直接返回文件内容）
+    // 合并结果按文件缓存：层文件未变化时直接复用，某一层变化时只重算它涉及的顶层键
+    json load_merged_config(const std::string& path);
+
+    // 按 self（path 处分层配置的内容）声明的层合并，各层内容由 layer_content(层的完整路径) 提供，不读缓存。
+    // 用于在写回之前按尚未落盘的内容（如迁移后的各层）得到合并结果
+    json merge_layers(const std::string& path, const json& self,
+                      const std::function<json(const std::string&)>& layer_content);
+
+    // 合并 path 处配置时读取的所有文件：各层依次排列，最后是文件自身；非分层配置只有自身
+    std::vector<std::string> config_layer_paths(const std::string& path);
+
+    // 暂存的合并结果：内容已写入 target 同目录下的临时文件 staged，尚未改名到位
+    struct staged_merged_config {
+        std::string target;   // configs/.merged/<文件名>
+        std::string staged;
+        json content;
+    };
+
+    // 把分层配置的合并结果写到 configs/.merged/ 下的临时文件，由调用方用 utils::filesystem::commit_file 换上
+    staged_merged_config stage_merged_config(const std::string& path);
+
+    // 把分层配置的合并结果原子地写到 configs/.merged/ 下（读者不会看到写了一半的文件），返回写入的路径
+    std::string materialize_merged_config(const std::string& path);
+
+}  // namespace config
@@ -0,0 +1,439 @@
+#include "migration.hpp"
+#include "config_file.hpp"
+#include "history.hpp"
+#include "layered_config.hpp"
+#include "schema_diff.hpp"
+#include "template_generator.hpp"
+#include "validator.hpp"
+#include "../utils/fs.hpp"
+#include "../utils/task_pool.hpp"
+#include "../utils/trace.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <set>
+
+namespace config {
+
+    namespace fs = std::filesystem;
+
+    namespace {
+
+        // 比较两个子 schema 的约束时忽略的关键字
+        const std::set<std::string> annotations = {
+            "title", "description", "default", "examples", "$comment", "readOnly", "writeOnly", "deprecated",
+        };
+
+        std::string escape_token(const std::string& token) {
+            std::string out;
+            for (char c : token) {
+                if (c == '~') out += "~0";
+                else if (c == '/') out += "~1";
+                else out += c;
+            }
+            return out;
+        }
+
+        std::string lower(std::string s) {
+            std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+            return s;
+        }
+
+        const json& properties_of(const json* schema) {
+            static const json empty = json::object();
+            if (!schema || !schema->is_object()) return empty;
+            auto it = schema->find("properties");
+            return it != schema->end() && it->is_object() ? *it : empty;
+        }
+
+        bool is_required(const json& schema, const std::string& key) {
+            auto it = schema.find("required");
+            if (it == schema.end() || !it->is_array()) return false;
+            return std::find(it->begin(), it->end(), json(key)) != it->end();
+        }
+
+        // 约束相同（忽略文档关键字和扩展关键字），用于识别改名
+        bool same_constraints(const json* a, const json* b) {
+            if (!a || !b) return false;
+            if (!a->is_object() || !b->is_object()) return *a == *b;
+            auto strip = [](const json& s) {
+                json out = json::object();
+                for (auto it = s.begin(); it != s.end(); ++it) {
+                    if (!annotations.count(it.key()) && it.key().rfind("x-", 0) != 0) out[it.key()] = it.value();
+                }
+                return out;
+            };
+            return strip(*a) == strip(*b);
+        }
+
+        bool type_matches(const json& value, const std::string& type) {
+            if (type == "null") return value.is_null();
+            if (type == "boolean") return value.is_boolean();
+            if (type == "object") return value.is_object();
+            if (type == "array") return value.is_array();
+            if (type == "string") return value.is_string();
+            if (type == "number") return value.is_number();
+            if (type == "integer") {
+                if (value.is_number_integer()) return true;
+                if (!value.is_number_float()) return false;
+                double d = value.get<double>();
+                return std::isfinite(d) && d == std::floor(d);
+            }
+            return true;
+        }
+
+        std::vector<std::string> types_of(const json& schema) {
+            std::vector<std::string> types;
+            auto it = schema.find("type");
+            if (it == schema.end()) return types;
+            if (it->is_string()) types.push_back(it->get<std::string>());
+            if (it->is_array()) {
+                for (const auto& t : *it) {
+                    if (t.is_string()) types.push_back(t.get<std::string>());
+                }
+            }
+            return types;
+        }
+
+        // 尝试把 value 转换为 type，成功时写入 out
+        bool convert(const json& value, const std::string& type, json& out) {
+            if (type == "string") {
+                if (value.is_number() || value.is_boolean()) {
+                    out = value.dump();
+                    return true;
+                }
+            } else if (type == "integer" || type == "number") {
+                if (value.is_string()) {
+                    const auto& s = value.get_ref<const std::string&>();
+                    if (s.empty()) return false;
+                    size_t used = 0;
+                    try {
+                        if (type == "integer") {
+                            long long n = std::stoll(s, &used);
+                            if (used == s.size()) out = static_cast<int64_t>(n);
+                        } else {
+                            double d = std::stod(s, &used);
+                            if (used == s.size()) out = d;
+                        }
+                    } catch (const std::exception&) {
+                        return false;
+                    }
+                    return used == s.size();
+                }
+                if (type == "integer" && value.is_number_float() && type_matches(value, "integer")) {
+                    // 超出 int64 范围的值（如 1e300）转换是未定义行为，保留原样
+                    double d = value.get<double>();
+                    if (d < -9223372036854775808.0 || d >= 9223372036854775808.0) return false;
+                    out = static_cast<int64_t>(d);
+                    return true;
+                }
+            } else if (type == "boolean") {
+                if (value.is_string()) {
+                    std::string s = lower(value.get<std::string>());
+                    if (s == "true" || s == "false") {
+                        out = s == "true";
+                        return true;
+                    }
+                }
+            } else if (type == "array") {
+                if (!value.is_array() && !value.is_null()) {
+                    out = json::array({value});
+                    return true;
+                }
+            }
+            // 单元素数组 -> 其中的值
+            if (value.is_array() && value.size() == 1 && type != "array") {
+                if (type_matches(value[0], type)) {
+                    out = value[0];
+                    return true;
+                }
+                return convert(value[0], type, out);
+            }
+            return false;
+        }
+
+        // 在新枚举中找与 value 等价的值：字符串不区分大小写，数字与其字符串形式等价
+        const json* match_enum(const json& value, const json& options) {
+            for (const auto& option : options) {
+                if (option == value) return &option;
+            }
+            std::string text = value.is_string() ? lower(value.get<std::string>()) : lower(value.dump());
+            for (const auto& option : options) {
+                std::string candidate = option.is_string() ? lower(option.get<std::string>()) : lower(option.dump());
+                if (candidate == text) return &option;
+            }
+            return nullptr;
+        }
+
+    }  // namespace
+
+    schema_migration::schema_migration(const json& old_schema, const json& new_schema)
+        : old_root_(old_schema), new_root_(new_schema) {}
+
+    void schema_migration::apply(json& config, migration_result& result, bool fill_missing) const {
+        migrate(config, &old_root_, &new_root_, "", result, fill_missing);
+    }
+
+    void schema_migration::migrate(json& value, const json* old_schema, const json* new_schema,
+                                   const std::string& pointer, migration_result& result, bool fill_missing) const {
+        if (old_schema) old_schema = follow_local_ref(old_schema, old_root_);
+        if (new_schema) new_schema = follow_local_ref(new_schema, new_root_);
+        if (!new_schema || !new_schema->is_object()) return;
+        std::string where = pointer.empty() ? "/" : pointer;
+
+        // 类型变化
+        auto types = types_of(*new_schema);
+        if (!types.empty() && std::none_of(types.begin(), types.end(),
+                                           [&](const std::string& t) { return type_matches(value, t); })) {
+            json converted;
+            bool done = false;
+            for (const auto& type : types) {
+                if (convert(value, type, converted)) {
+                    result.changes.push_back("~ " + where + ": " + value.dump() + " -> " + converted.dump());
+                    value = std::move(converted);
+                    done = true;
+                    break;
+                }
+            }
+            if (!done) {
+                result.unresolved.push_back(where + ": 无法将 " + value.dump() + " 转换为 " + new_schema->at("type").dump());
+                return;
+            }
+        }
+
+        // 枚举变化
+        auto options = new_schema->find("enum");
+        if (options != new_schema->end() && options->is_array() &&
+            std::find(options->begin(), options->end(), value) == options->end()) {
+            if (const json* match = match_enum(value, *options)) {
+                result.changes.push_back("~ " + where + ": " + value.dump() + " -> " + match->dump());
+                value = *match;
+            } else {
+                result.unresolved.push_back(where + ": " + value.dump() + " 不在新的枚举中");
+            }
+            return;
+        }
+
+        if (value.is_object()) {
+            migrate_object(value, old_schema, *new_schema, pointer, result, fill_missing);
+        } else if (value.is_array()) {
+            auto items = new_schema->find("items");
+            if (items == new_schema->end() || !items->is_object()) return;
+            const json* old_items = nullptr;
+            if (old_schema && old_schema->is_object() && old_schema->contains("items")) old_items = &(*old_schema)["items"];
+            for (size_t i = 0; i < value.size(); ++i) {
+                migrate(value[i], old_items, &*items, pointer + "/" + std::to_string(i), result, fill_missing);
+            }
+        }
+    }
+
+    void schema_migration::migrate_object(json& value, const json* old_schema, const json& new_schema,
+                                          const std::string& pointer, migration_result& result,
+                                          bool fill_missing) const {
+        const json& old_props = properties_of(old_schema);
+        const json& new_props = properties_of(&new_schema);
+
+        std::vector<std::string> removed;
+        std::vector<std::string> added;
+        for (auto it = old_props.begin(); it != old_props.end(); ++it) {
+            if (!new_props.contains(it.key())) removed.push_back(it.key());
+        }
+        for (auto it = new_props.begin(); it != new_props.end(); ++it) {
+            if (!old_props.contains(it.key())) added.push_back(it.key());
+        }
+
+        // 改名：新属性以 x-renamed-from 声明的旧名
+        std::map<std::string, std::string> renamed;  // 新名 -> 旧名
+        for (const auto& key : added) {
+            const json& schema = new_props[key];
+            auto from = schema.find("x-renamed-from");
+            if (from != schema.end() && from->is_string() && old_props.contains(from->get<std::string>())) {
+                renamed[key] = from->get<std::string>();
+            }
+        }
+        auto taken = [&renamed](const std::string& old_key) {
+            return std::any_of(renamed.begin(), renamed.end(), [&](const auto& r) { return r.second == old_key; });
+        };
+        // 没有声明时只在恰好剩下一个删除、一个新增属性且约束相同时认定为改名，避免把无关的同类型属性配对
+        std::vector<std::string> left_removed;
+        std::vector<std::string> left_added;
+        for (const auto& key : removed) {
+            if (!taken(key)) left_removed.push_back(key);
+        }
+        for (const auto& key : added) {
+            if (!renamed.count(key)) left_added.push_back(key);
+        }
+        if (left_removed.size() == 1 && left_added.size() == 1 &&
+            same_constraints(follow_local_ref(&old_props[left_removed[0]], old_root_),
+                             follow_local_ref(&new_props[left_added[0]], new_root_))) {
+            renamed[left_added[0]] = left_removed[0];
+        }
+
+        for (const auto& [key, old_key] : renamed) {
+            auto it = value.find(old_key);
+            if (it == value.end() || value.contains(key)) continue;
+            json moved = std::move(*it);
+            value.erase(old_key);
+            value[key] = std::move(moved);
+            result.changes.push_back("> " + pointer + "/" + escape_token(old_key) + " -> " + pointer + "/" + escape_token(key));
+        }
+
+        // 删除新 schema 中不再声明的属性
+        for (const auto& key : removed) {
+            if (taken(key) || !value.contains(key)) continue;
+            result.changes.push_back("- " + pointer + "/" + escape_token(key) + " (" + value[key].dump() + ")");
+            value.erase(key);
+        }
+
+        // 补上新增的和新变为必填的属性
+        if (fill_missing) {
+            for (auto it = new_props.begin(); it != new_props.end(); ++it) {
+                const std::string& key = it.key();
+                if (value.contains(key)) continue;
+                bool is_new = std::find(added.begin(), added.end(), key) != added.end();
+                if (!is_new && !is_required(new_schema, key)) continue;
+                json filled = generate_default_config(it.value());
+                result.changes.push_back("+ " + pointer + "/" + escape_token(key) + " = " + filled.dump());
+                value[key] = std::move(filled);
+            }
+        }
+
+        // 逐个迁移保留下来的属性
+        auto additional = new_schema.find("additionalProperties");
+        const json* old_additional = nullptr;
+        if (old_schema && old_schema->is_object() && old_schema->contains("additionalProperties")) {
+            old_additional = &(*old_schema)["additionalProperties"];
+        }
+        for (auto it = value.begin(); it != value.end(); ++it) {
+            const std::string& key = it.key();
+            std::string child = pointer + "/" + escape_token(key);
+            auto new_child = new_props.find(key);
+            if (new_child != new_props.end()) {
+                auto from = renamed.find(key);
+                const std::string& old_key = from != renamed.end() ? from->second : key;
+                const json* old_child = old_props.contains(old_key) ? &old_props[old_key] : old_additional;
+                migrate(it.value(), old_child, &*new_child, child, result, fill_missing);
+            } else if (additional != new_schema.end() && additional->is_object()) {
+                const json* old_child = old_props.contains(key) ? &old_props[key] : old_additional;
+                migrate(it.value(), old_child, &*additional, child, result, fill_missing);
+            }
+        }
+    }
+
+    std::vector<migration_result> migrate_configs(const std::string& configs_dir, const json& old_schema,
+                                                  const json& new_schema, const std::string& schema_dir, bool dry_run,
+                                                  bool force, unsigned threads) {
+        TRACE_SCOPE("migrate_configs", "config", configs_dir);
+        schema_migration migration(old_schema, new_schema);
+        auto files = utils::filesystem::list_json_files(configs_dir);
+        std::vector<migration_result> results(files.size());
+        std::vector<json> migrated(files.size());
+        std::vector<char> layered(files.size(), 0);
+
+        // 第一步，每个文件一个任务：读取、迁移，并校验非分层配置；此时不写任何文件
+        std::vector<std::function<void()>> tasks;
+        for (size_t i = 0; i < files.size(); ++i) {
+            tasks.push_back([&, i] {
+                auto& result = results[i];
+                result.file = files[i];
+                std::string path = (fs::path(configs_dir) / files[i]).string();
+                try {
+                    json config = load_config(path);
+                    layered[i] = is_layered(config);
+                    migration.apply(config, result, !layered[i]);
+                    if (!layered[i]) {
+                        try {
+                            validate_config(config, new_schema, schema_dir);
+                        } catch (const std::exception& e) {
+                            result.validation = e.what();
+                        }
+                        result.validated = true;
+                    }
+                    migrated[i] = std::move(config);
+                } catch (const std::exception& e) {
+                    result.error = e.what();
+                }
+            });
+        }
+        utils::run_tasks(tasks, threads);
+
+        // 第二步，分层配置按迁移后（尚未写回）的各层内容合并再校验；不在 configs_dir 中的层从磁盘读取
+        std::map<std::string, size_t> index_of;
+        for (size_t i = 0; i < files.size(); ++i) {
+            index_of[fs::absolute(fs::path(configs_dir) / files[i]).lexically_normal().string()] = i;
+        }
+        auto layer_content = [&](const std::string& layer_path) -> json {
+            auto it = index_of.find(fs::absolute(layer_path).lexically_normal().string());
+            if (it == index_of.end()) return load_config(layer_path);
+            if (!results[it->second].error.empty()) {
+                throw std::runtime_error("Config layer could not be migrated: " + layer_path);
+            }
+            return migrated[it->second];
+        };
+        tasks.clear();
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (!layered[i] || !results[i].error.empty()) continue;
+            tasks.push_back([&, i] {
+                std::string path = (fs::path(configs_dir) / files[i]).string();
+                try {
+                    validate_config(merge_layers(path, migrated[i], layer_content), new_schema, schema_dir);
+                } catch (const std::exception& e) {
+                    results[i].validation = e.what();
+                }
+                results[i].validated = true;
+            });
+        }
+        utils::run_tasks(tasks, threads);
+
+        // 第三步，全部通过（或 force）时才写回：任何一个文件读取、迁移或校验失败，所有文件都保持原样
+        if (dry_run) return results;
+        if (!force) {
+            for (const auto& result : results) {
+                if (!result.error.empty() || !result.validation.empty()) return results;
+            }
+        }
+        tasks.clear();
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (!results[i].error.empty() || results[i].changes.empty()) continue;
+            tasks.push_back([&, i] {
+                try {
+                    utils::filesystem::write_file_atomic((fs::path(configs_dir) / files[i]).string(),
+                                                         migrated[i].dump(4));
+                    results[i].written = true;
+                } catch (const std::exception& e) {
+                    results[i].error = e.what();
+                }
+            });
+        }
+        utils::run_tasks(tasks, threads);
+        utils::filesystem::sync_dir(configs_dir);
+
+        // 写回绕过了 save_config：active 指向以这些文件为层的合并结果时同样需要重新生成
+        std::vector<std::string> written;
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (results[i].written) written.push_back((fs::path(configs_dir) / files[i]).string());
+        }
+        if (!written.empty()) {
+            try {
+                refresh_active_merged(configs_dir, written);
+            } catch (const std::exception& e) {
+                std::string active = utils::filesystem::read_symlink((fs::path(configs_dir) / "active").string());
+                std::string name = fs::path(active).filename().string();
+                for (auto& result : results) {
+                    if (result.file == name) result.error = "Failed to refresh merged config: " + std::string(e.what());
+                }
+            }
+        }
+
+        // 写回的配置记入版本历史
+        auto& history = version_store_for(fs::path(configs_dir).parent_path().string());
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (results[i].written) history.record("migrate", files[i], migrated[i]);
+        }
+        return results;
+    }
+
+}  // namespace config
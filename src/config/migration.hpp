@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "json_type.hpp"
+
+namespace config {
+
+    // 一个配置文件的迁移结果
+    struct migration_result {
+        std::string file;
+        std::vector<std::string> changes;     // 每项修改一行，如 "+ /db/timeout = 30"、"- /legacy"、"~ /mode: \"Fast\" -> \"fast\""
+        std::vector<std::string> unresolved;  // 无法自动迁移的位置及原因
+        std::string error;                    // 读取、解析或写入失败
+        bool validated = false;               // 是否已按新 schema 校验（读取或迁移失败时未校验）
+        std::string validation;               // 校验失败的信息，通过时为空
+        bool written = false;                 // 是否已写回文件
+    };
+
+    // 由新旧 schema 的差异迁移配置：
+    //   新增的属性和新变为必填的属性按 generate_default_config 的默认值补上；
+    //   旧 schema 中声明、新 schema 中删除的属性被删除，能认定为改名的则改名——
+    //   新属性带 "x-renamed-from": "<旧名>"，或同一对象中只删除了一个、新增了一个属性且二者约束相同；
+    //   类型变化时尽量转换（数字 <-> 字符串、"true"/"false" -> 布尔、整数值的浮点数 -> 整数、单值 <-> 单元素数组），
+    //   枚举变化时按不区分大小写或数字与字符串等值匹配新枚举。无法转换的值保留原样并记入 unresolved。
+    // 新 schema 的 $ref 需要能经 schema 注册表解析（先以新 schema 的路径 install_schema）。
+    class schema_migration {
+    public:
+        schema_migration(const json& old_schema, const json& new_schema);
+
+        // 原地迁移 config；fill_missing 为 false 时不补新属性（分层配置的覆盖层由基础配置提供）
+        void apply(json& config, migration_result& result, bool fill_missing = true) const;
+
+    private:
+        void migrate(json& value, const json* old_schema, const json* new_schema, const std::string& pointer,
+                     migration_result& result, bool fill_missing) const;
+        void migrate_object(json& value, const json* old_schema, const json& new_schema, const std::string& pointer,
+                            migration_result& result, bool fill_missing) const;
+
+        const json& old_root_;
+        const json& new_root_;
+    };
+
+    // 迁移 configs_dir 下的所有配置：每个文件一个任务在线程池中并行处理，结果按文件名排序。
+    // 先迁移并按新 schema（$ref 相对 schema_dir 解析）校验全部文件，分层配置按迁移后各层的合并结果校验；
+    // dry_run 时只生成报告。只有全部文件都迁移成功且校验通过（或 force）时才写回，否则不写任何文件。
+    // 写入时每个文件先写临时文件再 rename，读者看到的要么是旧内容要么是新内容。
+    std::vector<migration_result> migrate_configs(const std::string& configs_dir, const json& old_schema,
+                                                  const json& new_schema, const std::string& schema_dir, bool dry_run,
+                                                  bool force = false, unsigned threads = 0);
+
+}  // namespace config
@@ -0,0 +1,152 @@
+#include "schema_diff.hpp"
+#include <algorithm>
+#include <set>
+#include <utility>
+
+namespace config {
+
+    namespace {
+
+        // 遍历结构用的关键字（逐个比较子 schema），以及只影响文档的关键字
+        const std::set<std::string> structural = {"properties", "items", "additionalProperties"};
+        const std::set<std::string> annotations = {
+            "title", "description", "default", "examples", "$schema", "$comment", "definitions", "$defs",
+            "readOnly", "writeOnly", "deprecated",
+        };
+
+        // 超过该深度（如递归 schema）不再细分，直接视为变化
+        constexpr int max_depth = 64;
+
+        std::string escape_token(const std::string& token) {
+            std::string out;
+            for (char c : token) {
+                if (c == '~') out += "~0";
+                else if (c == '/') out += "~1";
+                else out += c;
+            }
+            return out;
+        }
+
+    }  // namespace
+
+    const json* follow_local_ref(const json* node, const json& root) {
+        for (int hops = 0; node->is_object() && node->contains("$ref"); ++hops) {
+            const json& ref = (*node)["$ref"];
+            if (!ref.is_string() || hops > 32) return nullptr;
+            const auto& target = ref.get_ref<const std::string&>();
+            if (target.empty() || target[0] != '#') return node;  // 外部文件引用按原样比较
+            try {
+                node = &root.at(json::json_pointer(target.substr(1)));
+            } catch (const std::exception&) {
+                return nullptr;
+            }
+        }
+        return node;
+    }
+
+    namespace {
+
+        class differ {
+        public:
+            differ(const json& before, const json& after) : before_(before), after_(after) {}
+
+            void compare(const json* a, const json* b, const std::string& path, int depth) {
+                a = follow_local_ref(a, before_);
+                b = follow_local_ref(b, after_);
+                if (a && b && *a == *b) return;
+                // 递归引用回到正在比较的一对子 schema 时不再展开
+                if (!a || !b || depth > max_depth || !a->is_object() || !b->is_object() || has_ref(*a) || has_ref(*b) ||
+                    !active_.insert({a, b}).second) {
+                    changed_.push_back(path);
+                    return;
+                }
+                compare_object(*a, *b, path, depth);
+                active_.erase({a, b});
+            }
+
+            void compare_object(const json& a_node, const json& b_node, const std::string& path, int depth) {
+                const json* a = &a_node;
+                const json* b = &b_node;
+
+                // 自身约束的变化影响整个子树
+                for (const auto* side : {a, b}) {
+                    for (auto it = side->begin(); it != side->end(); ++it) {
+                        const std::string& key = it.key();
+                        if (structural.count(key) || annotations.count(key) || key.rfind("x-", 0) == 0) continue;
+                        auto ia = a->find(key);
+                        auto ib = b->find(key);
+                        if (ia == a->end() || ib == b->end() || !(*ia == *ib)) {
+                            changed_.push_back(path);
+                            return;
+                        }
+                    }
+                }
+
+                compare_properties(*a, *b, path, depth);
+                compare_child(*a, *b, "items", path + "/*", depth);
+                compare_child(*a, *b, "additionalProperties", path + "/*", depth);
+            }
+
+            std::vector<std::string> result() {
+                // 去掉已被祖先位置覆盖的路径
+                std::sort(changed_.begin(), changed_.end());
+                changed_.erase(std::unique(changed_.begin(), changed_.end()), changed_.end());
+                std::vector<std::string> out;
+                for (const auto& path : changed_) {
+                    bool covered = std::any_of(out.begin(), out.end(), [&](const std::string& parent) {
+                        return parent.empty() || (path.compare(0, parent.size(), parent) == 0 && path[parent.size()] == '/');
+                    });
+                    if (!covered) out.push_back(path);
+                }
+                return out;
+            }
+
+        private:
+            static bool has_ref(const json& node) { return node.contains("$ref"); }
+
+            void compare_properties(const json& a, const json& b, const std::string& path, int depth) {
+                static const json empty = json::object();
+                const json& pa = a.contains("properties") ? a["properties"] : empty;
+                const json& pb = b.contains("properties") ? b["properties"] : empty;
+                if (!pa.is_object() || !pb.is_object()) {
+                    if (!(pa == pb)) changed_.push_back(path);
+                    return;
+                }
+                for (auto it = pa.begin(); it != pa.end(); ++it) {
+                    std::string child = path + "/" + escape_token(it.key());
+                    auto other = pb.find(it.key());
+                    // 删除的属性改由 additionalProperties 约束，同样需要重新校验
+                    if (other == pb.end()) changed_.push_back(child);
+                    else compare(&it.value(), &*other, child, depth + 1);
+                }
+                for (auto it = pb.begin(); it != pb.end(); ++it) {
+                    if (!pa.contains(it.key())) changed_.push_back(path + "/" + escape_token(it.key()));
+                }
+            }
+
+            void compare_child(const json& a, const json& b, const char* key, const std::string& path, int depth) {
+                auto ia = a.find(key);
+                auto ib = b.find(key);
+                if (ia == a.end() && ib == b.end()) return;
+                if (ia == a.end() || ib == b.end()) {
+                    changed_.push_back(path);
+                    return;
+                }
+                compare(&*ia, &*ib, path, depth + 1);
+            }
+
+            const json& before_;
+            const json& after_;
+            std::vector<std::string> changed_;
+            std::set<std::pair<const json*, const json*>> active_;
+        };
+
+    }  // namespace
+
+    std::vector<std::string> changed_instance_paths(const json& before, const json& after) {
+        differ d(before, after);
+        d.compare(&before, &after, "", 0);
+        return d.result();
+    }
+
+}  // namespace config
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "json_type.hpp"
+
+namespace config {
+
+    // 比较新旧两个 schema，返回校验结果可能变化的实例位置（JSON Pointer，段为 * 时匹配任意成员或元素）
+    // 沿 properties / items / additionalProperties 同时遍历两个 schema，本地 $ref 跟随到引用目标；
+    // 某个子 schema 自身的约束关键字变化时记录它的位置，不再向下比较。只影响文档的关键字
+    // （title、description、default 等）不算变化。两个 schema 相同时返回空，整体替换时返回 {""}。
+    std::vector<std::string> changed_instance_paths(const json& before, const json& after);
+
+    // 在 root 中跟随本地 $ref（"#..."）到最终目标；外部文件引用原样返回，无法解析或循环时返回 nullptr
+    const json* follow_local_ref(const json* node, const json& root);
+
+}  // namespace config
@@ -1,10 +1,14 @@
 #include "schema_loader.hpp"
+#include "schema_registry.hpp"
+#include "template_generator.hpp"
+#include "validator.hpp"
+#include "../utils/trace.hpp"
 #include <fstream>
 #include <stdexcept>
 
 namespace config {
 
-    json load_schema(const std::string& schema_path) {
+    json read_schema(const std::string& schema_path) {
         std::ifstream ifs(schema_path);
         if (!ifs.is_open()) {
             throw std::runtime_error("Failed to open schema file: " + schema_path);
@@ -16,8 +20,21 @@ namespace config {
         } catch (const nlohmann::json::parse_error& e) {
             throw std::runtime_error("Failed to parse schema JSON: " + std::string(e.what()));
         }
+        return schema_json;
+    }
 
+    json load_schema(const std::string& schema_path) {
+        TRACE_SCOPE("load_schema", "config", schema_path);
+        json schema_json = read_schema(schema_path);
+        install_schema(schema_path, schema_json);
         return schema_json;
     }
 
+    void install_schema(const std::string& schema_path, const json& schema) {
+        // 预加载 $ref 引用的文件；旧 schema 的默认值缓存和编译好的校验程序随之失效
+        register_schema(schema_path, schema);
+        clear_default_config_cache();
+        clear_validation_cache();
+    }
+
 }  // namespace config
\ No newline at end of file
@@ -1,12 +1,16 @@
 #pragma once
 
 #include <string>
-#include <nlohmann/json.hpp>
+#include "json_type.hpp"
 
 namespace config {
 
-    using json = nlohmann::ordered_json;
-
     json load_schema(const std::string& schema_path);
 
+    // 只读取并解析 schema 文件，不登记到 schema 注册表（同时处理多个应用的 schema 时使用）
+    json read_schema(const std::string& schema_path);
+
+    // 以已解析的 schema 作为当前 schema：登记到注册表并清空依赖旧 schema 的缓存（热加载时在界面线程调用）
+    void install_schema(const std::string& schema_path, const json& schema);
+
 }  // namespace config
\ No newline at end of file
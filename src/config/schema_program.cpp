@@ -0,0 +1,684 @@
+#include "schema_program.hpp"
+#include "../utils/task_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <numeric>
+#include <set>
+
+namespace config {
+
+    namespace fs = std::filesystem;
+
+    namespace {
+
+        enum type_bit : uint8_t {
+            t_null = 1, t_boolean = 2, t_object = 4, t_array = 8, t_number = 16, t_string = 32, t_integer = 64,
+        };
+
+        // 只影响文档、不影响校验的关键字
+        const std::set<std::string> annotations = {
+            "title", "description", "default", "examples", "$schema", "$comment", "definitions", "$defs",
+            "readOnly", "writeOnly", "deprecated",
+        };
+
+        uint8_t type_bit_of(const std::string& name) {
+            if (name == "null") return t_null;
+            if (name == "boolean") return t_boolean;
+            if (name == "object") return t_object;
+            if (name == "array") return t_array;
+            if (name == "number") return t_number;
+            if (name == "string") return t_string;
+            if (name == "integer") return t_integer;
+            return 0;
+        }
+
+        bool type_matches(uint8_t types, const json& instance) {
+            switch (instance.type()) {
+                case json::value_t::null: return types & t_null;
+                case json::value_t::boolean: return types & t_boolean;
+                case json::value_t::object: return types & t_object;
+                case json::value_t::array: return types & t_array;
+                case json::value_t::string: return types & t_string;
+                case json::value_t::number_integer:
+                case json::value_t::number_unsigned:
+                    return types & (t_number | t_integer);
+                case json::value_t::number_float: {
+                    if (types & t_number) return true;
+                    // 小数部分为 0 的浮点数也算整数
+                    double d = instance.get<double>();
+                    return (types & t_integer) && std::isfinite(d) && d == std::floor(d);
+                }
+                default:
+                    return false;
+            }
+        }
+
+        constexpr uint64_t fnv_offset = 1469598103934665603ULL;
+        constexpr uint64_t fnv_prime = 1099511628211ULL;
+
+        uint64_t mix(uint64_t h, const void* data, size_t len) {
+            auto p = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < len; ++i) {
+                h ^= p[i];
+                h *= fnv_prime;
+            }
+            return h;
+        }
+
+        std::string escape_token(const std::string& token) {
+            std::string out;
+            for (char c : token) {
+                if (c == '~') out += "~0";
+                else if (c == '/') out += "~1";
+                else out += c;
+            }
+            return out;
+        }
+
+        // 字符串长度按 Unicode 码点计算
+        size_t utf8_length(const std::string& s) {
+            size_t n = 0;
+            for (char c : s) {
+                if ((static_cast<unsigned char>(c) & 0xC0) != 0x80) ++n;
+            }
+            return n;
+        }
+
+        // 非负整数（schema 解析得到的是无符号数，代码中构造的可能是有符号数）
+        bool is_count(const json& value) {
+            return value.is_number_integer() && value.get<int64_t>() >= 0;
+        }
+
+        std::string number_text(double d) {
+            return json(d).dump();
+        }
+
+    }  // namespace
+
+    uint64_t value_hash(const json& value) {
+        uint64_t h = fnv_offset;
+        if (value.is_number()) {
+            double d = value.get<double>();
+            if (d == 0) d = 0;  // -0.0 与 0.0 相等
+            uint8_t tag = 'n';
+            h = mix(h, &tag, 1);
+            return mix(h, &d, sizeof(d));
+        }
+        auto tag = static_cast<uint8_t>(value.type());
+        h = mix(h, &tag, 1);
+        switch (value.type()) {
+            case json::value_t::string: {
+                const auto& s = value.get_ref<const std::string&>();
+                return mix(h, s.data(), s.size());
+            }
+            case json::value_t::boolean: {
+                uint8_t b = value.get<bool>() ? 1 : 0;
+                return mix(h, &b, 1);
+            }
+            case json::value_t::array:
+                for (const auto& item : value) {
+                    uint64_t child = value_hash(item);
+                    h = mix(h, &child, sizeof(child));
+                }
+                return h;
+            case json::value_t::object: {
+                // 对象相等与键的顺序无关：各成员哈希相加
+                uint64_t sum = 0;
+                for (auto it = value.begin(); it != value.end(); ++it) {
+                    uint64_t member = mix(fnv_offset, it.key().data(), it.key().size());
+                    uint64_t child = value_hash(it.value());
+                    sum += mix(member, &child, sizeof(child));
+                }
+                return mix(h, &sum, sizeof(sum));
+            }
+            default:
+                return h;
+        }
+    }
+
+    void schema_program::value_set::insert(const json& value) {
+        auto& bucket = buckets_[value_hash(value)];
+        for (const auto& v : bucket) {
+            if (v == value) return;
+        }
+        bucket.push_back(value);
+    }
+
+    bool schema_program::value_set::contains(const json& value) const {
+        auto it = buckets_.find(value_hash(value));
+        if (it == buckets_.end()) return false;
+        for (const auto& v : it->second) {
+            if (v == value) return true;
+        }
+        return false;
+    }
+
+    schema_program::schema_program(const json& schema, const document_loader& loader) : loader_(&loader) {
+        try {
+            compile(schema, "", schema);
+        } catch (const std::exception& e) {
+            // 引用无法解析、正则无法编译等：交给校验库报告
+            fail(std::string("(") + e.what() + ")");
+        }
+        loader_ = nullptr;
+        compiled_.clear();
+    }
+
+    void schema_program::fail(const std::string& keyword) {
+        if (complete_) unsupported_ = keyword;
+        complete_ = false;
+    }
+
+    const json* schema_program::resolve(const std::string& ref, std::string& doc_path, const json*& doc_root) {
+        if (ref.find("://") != std::string::npos) {
+            fail("$ref " + ref);
+            return nullptr;
+        }
+        auto hash = ref.find('#');
+        std::string file = ref.substr(0, hash);
+        std::string fragment = hash == std::string::npos ? "" : ref.substr(hash + 1);
+        if (!file.empty()) {
+            doc_path = (fs::path(doc_path).parent_path() / file).lexically_normal().generic_string();
+            if (std::find(documents_.begin(), documents_.end(), doc_path) == documents_.end()) {
+                documents_.push_back(doc_path);
+            }
+            doc_root = &(*loader_)(doc_path);
+        }
+        if (fragment.empty()) return doc_root;
+        if (fragment[0] != '/') {
+            fail("$ref " + ref);  // 按 $id / 锚点引用
+            return nullptr;
+        }
+        return &doc_root->at(json::json_pointer(fragment));
+    }
+
+    int32_t schema_program::compile(const json& schema, const std::string& doc_path, const json& doc_root) {
+        auto found = compiled_.find(&schema);
+        if (found != compiled_.end()) return found->second;
+
+        // $ref：节点就是引用目标的节点（draft 7 中 $ref 的兄弟关键字被忽略）
+        if (schema.is_object() && schema.contains("$ref") && schema["$ref"].is_string()) {
+            std::string target_path = doc_path;
+            const json* target_root = &doc_root;
+            const json* target = resolve(schema["$ref"].get<std::string>(), target_path, target_root);
+            if (!target) return 0;
+            // 先占位，避免循环引用无限展开
+            auto index = static_cast<int32_t>(nodes_.size());
+            nodes_.emplace_back();
+            compiled_[&schema] = index;
+            int32_t resolved = compile(*target, target_path, *target_root);
+            nodes_[index] = nodes_[resolved];
+            compiled_[&schema] = resolved;
+            return resolved;
+        }
+
+        auto index = static_cast<int32_t>(nodes_.size());
+        nodes_.emplace_back();
+        compiled_[&schema] = index;
+
+        if (schema.is_boolean()) {
+            nodes_[index].always_fail = !schema.get<bool>();
+            return index;
+        }
+        if (!schema.is_object()) {
+            fail("(non-object schema)");
+            return index;
+        }
+
+        node n;
+        std::vector<property> props;
+        std::vector<std::string> required;
+        for (auto it = schema.begin(); it != schema.end(); ++it) {
+            const std::string& key = it.key();
+            const json& value = it.value();
+            // x- 开头的是扩展关键字（如迁移用的 x-renamed-from），校验时忽略
+            if (annotations.count(key) || key.rfind("x-", 0) == 0 || (key == "$id" && &schema == &doc_root)) continue;
+
+            if (key == "type") {
+                if (value.is_string()) {
+                    n.types = type_bit_of(value.get<std::string>());
+                } else if (value.is_array()) {
+                    for (const auto& t : value) n.types |= type_bit_of(t.get<std::string>());
+                }
+                if (n.types == 0) fail("type");
+            } else if (key == "enum" && value.is_array()) {
+                value_set set;
+                for (const auto& v : value) set.insert(v);
+                n.enum_set = static_cast<int32_t>(enums_.size());
+                enums_.push_back(std::move(set));
+            } else if (key == "const") {
+                n.const_value = static_cast<int32_t>(consts_.size());
+                consts_.push_back(value);
+            } else if (key == "minimum" && value.is_number()) {
+                n.has_minimum = true;
+                n.minimum = value.get<double>();
+            } else if (key == "maximum" && value.is_number()) {
+                n.has_maximum = true;
+                n.maximum = value.get<double>();
+            } else if (key == "exclusiveMinimum" && value.is_number()) {
+                n.has_exclusive_minimum = true;
+                n.exclusive_minimum_value = value.get<double>();
+            } else if (key == "exclusiveMaximum" && value.is_number()) {
+                n.has_exclusive_maximum = true;
+                n.exclusive_maximum_value = value.get<double>();
+            } else if (key == "minLength" && is_count(value)) {
+                n.min_length = value.get<int64_t>();
+            } else if (key == "maxLength" && is_count(value)) {
+                n.max_length = value.get<int64_t>();
+            } else if (key == "pattern" && value.is_string()) {
+                n.pattern = static_cast<int32_t>(patterns_.size());
+                patterns_.push_back({value.get<std::string>(), std::regex(value.get<std::string>(), std::regex::ECMAScript)});
+            } else if (key == "minItems" && is_count(value)) {
+                n.min_items = value.get<int64_t>();
+            } else if (key == "maxItems" && is_count(value)) {
+                n.max_items = value.get<int64_t>();
+            } else if (key == "uniqueItems" && value.is_boolean()) {
+                n.unique_items = value.get<bool>();
+            } else if (key == "minProperties" && is_count(value)) {
+                n.min_properties = value.get<int64_t>();
+            } else if (key == "maxProperties" && is_count(value)) {
+                n.max_properties = value.get<int64_t>();
+            } else if (key == "items" && (value.is_object() || value.is_boolean())) {
+                n.items = -2;  // 子节点在下面编译（nodes_ 可能扩容，不能持有引用）
+            } else if (key == "additionalProperties" && (value.is_object() || value.is_boolean())) {
+                n.additional = -2;
+            } else if (key == "required" && value.is_array()) {
+                for (const auto& r : value) required.push_back(r.get<std::string>());
+            } else if (key == "properties" && value.is_object()) {
+                for (auto p = value.begin(); p != value.end(); ++p) props.push_back({p.key(), -1});
+            } else {
+                fail(key);
+            }
+        }
+
+        // 子 schema
+        if (n.items == -2) n.items = compile(schema["items"], doc_path, doc_root);
+        if (n.additional == -2) {
+            n.additional = compile(schema["additionalProperties"], doc_path, doc_root);
+            n.known_keys = static_cast<int32_t>(known_keys_.size());
+            known_keys_.emplace_back();
+            for (const auto& p : props) known_keys_.back().insert(p.key);
+        }
+        for (auto& p : props) p.node = compile(schema["properties"][p.key], doc_path, doc_root);
+
+        n.props_begin = static_cast<uint32_t>(properties_.size());
+        for (auto& p : props) properties_.push_back(std::move(p));
+        n.props_end = static_cast<uint32_t>(properties_.size());
+        n.required_begin = static_cast<uint32_t>(required_.size());
+        for (auto& r : required) required_.push_back(std::move(r));
+        n.required_end = static_cast<uint32_t>(required_.size());
+
+        nodes_[index] = n;
+        return index;
+    }
+
+    void schema_program::error(const std::string& pointer, const json& instance, std::string message,
+                               std::vector<validation_error>& errors) const {
+        errors.push_back({pointer, instance.dump(), std::move(message)});
+    }
+
+    void schema_program::run(const json& instance, std::vector<validation_error>& errors) const {
+        std::string pointer;
+        run_node(root(), instance, pointer, errors);
+    }
+
+    bool schema_program::check(const node& n, const json& instance, const std::string& pointer,
+                               std::vector<validation_error>& errors, bool unique) const {
+        if (n.always_fail) {
+            error(pointer, instance, "instance invalid as per false-schema", errors);
+            return false;
+        }
+        if (n.types && !type_matches(n.types, instance)) {
+            error(pointer, instance, "unexpected instance type", errors);
+            return false;
+        }
+        if (n.enum_set >= 0 && !enums_[n.enum_set].contains(instance)) {
+            error(pointer, instance, "instance not found in required enum", errors);
+        }
+        if (n.const_value >= 0 && !(instance == consts_[n.const_value])) {
+            error(pointer, instance, "instance not const", errors);
+        }
+
+        switch (instance.type()) {
+            case json::value_t::string: {
+                const auto& s = instance.get_ref<const std::string&>();
+                if (n.min_length >= 0 || n.max_length >= 0) {
+                    auto length = static_cast<int64_t>(utf8_length(s));
+                    if (n.min_length >= 0 && length < n.min_length) {
+                        error(pointer, instance, "instance is too short as per minLength:" + std::to_string(n.min_length), errors);
+                    }
+                    if (n.max_length >= 0 && length > n.max_length) {
+                        error(pointer, instance, "instance is too long as per maxLength: " + std::to_string(n.max_length), errors);
+                    }
+                }
+                if (n.pattern >= 0 && !std::regex_search(s, patterns_[n.pattern].regex)) {
+                    error(pointer, instance, "instance does not match regex pattern: " + patterns_[n.pattern].source, errors);
+                }
+                break;
+            }
+            case json::value_t::number_integer:
+            case json::value_t::number_unsigned:
+            case json::value_t::number_float: {
+                double d = instance.get<double>();
+                if (n.has_exclusive_minimum && d <= n.exclusive_minimum_value) {
+                    error(pointer, instance, "instance is below or equals minimum of " + number_text(n.exclusive_minimum_value),
+                          errors);
+                }
+                if (n.has_minimum && d < n.minimum) {
+                    error(pointer, instance, "instance is below minimum of " + number_text(n.minimum), errors);
+                }
+                if (n.has_exclusive_maximum && d >= n.exclusive_maximum_value) {
+                    error(pointer, instance, "instance exceeds or equals maximum of " + number_text(n.exclusive_maximum_value),
+                          errors);
+                }
+                if (n.has_maximum && d > n.maximum) {
+                    error(pointer, instance, "instance exceeds maximum of " + number_text(n.maximum), errors);
+                }
+                break;
+            }
+            case json::value_t::array: {
+                auto size = static_cast<int64_t>(instance.size());
+                if (n.min_items >= 0 && size < n.min_items) error(pointer, instance, "array has too few items", errors);
+                if (n.max_items >= 0 && size > n.max_items) error(pointer, instance, "array has too many items", errors);
+                if (n.unique_items && unique) {
+                    value_set seen;
+                    for (const auto& item : instance) {
+                        if (seen.contains(item)) {
+                            error(pointer, instance, "items have to be unique for this array", errors);
+                            break;
+                        }
+                        seen.insert(item);
+                    }
+                }
+                break;
+            }
+            case json::value_t::object: {
+                auto size = static_cast<int64_t>(instance.size());
+                if (n.min_properties >= 0 && size < n.min_properties) {
+                    error(pointer, instance, "too few properties", errors);
+                }
+                if (n.max_properties >= 0 && size > n.max_properties) {
+                    error(pointer, instance, "too many properties", errors);
+                }
+                for (uint32_t r = n.required_begin; r < n.required_end; ++r) {
+                    if (instance.find(required_[r]) == instance.end()) {
+                        error(pointer, instance, "required property '" + required_[r] + "' not found in object", errors);
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        return true;
+    }
+
+    void schema_program::run_node(int32_t index, const json& instance, std::string& pointer,
+                                  std::vector<validation_error>& errors) const {
+        const node& n = nodes_[index];
+        if (!check(n, instance, pointer, errors, true)) return;
+
+        switch (instance.type()) {
+            case json::value_t::array: {
+                if (n.items >= 0) {
+                    size_t length = pointer.size();
+                    size_t i = 0;
+                    for (const auto& item : instance) {
+                        pointer += '/';
+                        pointer += std::to_string(i++);
+                        run_node(n.items, item, pointer, errors);
+                        pointer.resize(length);
+                    }
+                }
+                break;
+            }
+            case json::value_t::object: {
+                size_t length = pointer.size();
+                for (uint32_t p = n.props_begin; p < n.props_end; ++p) {
+                    auto it = instance.find(properties_[p].key);
+                    if (it == instance.end()) continue;
+                    pointer += '/';
+                    pointer += escape_token(properties_[p].key);
+                    run_node(properties_[p].node, *it, pointer, errors);
+                    pointer.resize(length);
+                }
+                if (n.additional >= 0) {
+                    const auto& known = known_keys_[n.known_keys];
+                    for (auto it = instance.begin(); it != instance.end(); ++it) {
+                        if (known.count(it.key())) continue;
+                        pointer += '/';
+                        pointer += escape_token(it.key());
+                        run_node(n.additional, it.value(), pointer, errors);
+                        pointer.resize(length);
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    size_t schema_program::run_path(const std::string& path, const json& instance,
+                                    std::vector<validation_error>& errors) const {
+        std::vector<std::string> tokens;
+        for (size_t pos = 0; pos < path.size();) {
+            size_t next = path.find('/', pos + 1);
+            if (next == std::string::npos) next = path.size();
+            std::string token = path.substr(pos + 1, next - pos - 1);
+            for (size_t i = 0; (i = token.find('~', i)) != std::string::npos; ++i) {
+                if (i + 1 < token.size()) token.replace(i, 2, token[i + 1] == '1' ? "/" : "~");
+            }
+            tokens.push_back(std::move(token));
+            pos = next;
+        }
+        std::string pointer;
+        return run_segments(root(), instance, tokens, 0, pointer, errors);
+    }
+
+    size_t schema_program::run_segments(int32_t index, const json& instance, const std::vector<std::string>& tokens,
+                                        size_t depth, std::string& pointer,
+                                        std::vector<validation_error>& errors) const {
+        if (depth == tokens.size()) {
+            if (index >= 0) run_node(index, instance, pointer, errors);
+            return 1;
+        }
+        // 没有约束的子树，或实例类型与路径不符（该处的类型错误由父节点报告，不在受影响的子树内）
+        if (index < 0 || nodes_[index].always_fail) return 0;
+        const node& n = nodes_[index];
+        const std::string& token = tokens[depth];
+        size_t length = pointer.size();
+        size_t matched = 0;
+
+        auto descend = [&](int32_t child, const json& value, const std::string& escaped) {
+            pointer += '/';
+            pointer += escaped;
+            matched += run_segments(child, value, tokens, depth + 1, pointer, errors);
+            pointer.resize(length);
+        };
+
+        if (instance.is_object()) {
+            // 成员对应的节点：properties 中的优先，否则为 additionalProperties
+            auto child_of = [&](const std::string& key) {
+                for (uint32_t p = n.props_begin; p < n.props_end; ++p) {
+                    if (properties_[p].key == key) return properties_[p].node;
+                }
+                return n.additional;
+            };
+            if (token == "*") {
+                for (auto it = instance.begin(); it != instance.end(); ++it) {
+                    descend(child_of(it.key()), it.value(), escape_token(it.key()));
+                }
+            } else {
+                auto it = instance.find(token);
+                if (it != instance.end()) descend(child_of(token), *it, escape_token(token));
+            }
+        } else if (instance.is_array()) {
+            if (token == "*") {
+                for (size_t i = 0; i < instance.size(); ++i) descend(n.items, instance[i], std::to_string(i));
+            } else if (!token.empty() && token.find_first_not_of("0123456789") == std::string::npos) {
+                size_t i = std::stoul(token);
+                if (i < instance.size()) descend(n.items, instance[i], token);
+            }
+        }
+        return matched;
+    }
+
+    // 并行校验的计划：错误按串行遍历的顺序分成若干段，每个任务只写自己的段，全部完成后按段的顺序拼接，
+    // 因此结果与 run 逐条一致
+    struct schema_program::parallel_plan {
+        struct child {
+            int32_t node;
+            const json* value;
+            std::string token;
+        };
+
+        // 分块判断的 uniqueItems：各块填写自己范围内元素的哈希，全部完成后再比较
+        struct unique_check {
+            const json* array;
+            std::string pointer;
+            size_t segment;
+            std::vector<uint64_t> hashes;
+        };
+
+        std::vector<std::vector<validation_error>> segments{1};
+        std::vector<std::function<void()>> tasks;
+        std::deque<std::vector<child>> children;
+        std::deque<unique_check> uniques;
+
+        // 当前线程内联校验的错误写入最后一段
+        std::vector<validation_error>& current() { return segments.back(); }
+
+        // 为任务预留一段，其后内联产生的错误写入新的一段
+        size_t reserve() {
+            segments.emplace_back();
+            segments.emplace_back();
+            return segments.size() - 2;
+        }
+    };
+
+    void schema_program::plan_node(int32_t index, const json& instance, std::string& pointer,
+                                   parallel_plan& plan) const {
+        const node& n = nodes_[index];
+        bool large = (instance.is_array() || instance.is_object()) && instance.size() >= parallel_grain;
+        bool defer_unique = large && instance.is_array() && n.unique_items;
+        if (!check(n, instance, pointer, plan.current(), !defer_unique)) return;
+        size_t length = pointer.size();
+
+        if (instance.is_array()) {
+            if (!large) {
+                if (n.items < 0) return;
+                size_t i = 0;
+                for (const auto& item : instance) {
+                    pointer += '/';
+                    pointer += std::to_string(i++);
+                    run_node(n.items, item, pointer, plan.current());
+                    pointer.resize(length);
+                }
+                return;
+            }
+
+            parallel_plan::unique_check* unique = nullptr;
+            if (defer_unique) {
+                plan.uniques.push_back({&instance, pointer, plan.reserve(), std::vector<uint64_t>(instance.size())});
+                unique = &plan.uniques.back();
+            }
+            if (n.items < 0 && !unique) return;
+            int32_t items = n.items;
+            for (size_t begin = 0; begin < instance.size(); begin += parallel_grain) {
+                size_t end = std::min(instance.size(), begin + parallel_grain);
+                size_t segment = items >= 0 ? plan.reserve() : 0;
+                plan.tasks.push_back([this, &plan, &instance, base = pointer, items, begin, end, segment, unique] {
+                    std::string path = base;
+                    for (size_t i = begin; i < end; ++i) {
+                        const json& item = instance[i];
+                        if (unique) unique->hashes[i] = value_hash(item);
+                        if (items < 0) continue;
+                        path += '/';
+                        path += std::to_string(i);
+                        run_node(items, item, path, plan.segments[segment]);
+                        path.resize(base.size());
+                    }
+                });
+            }
+            return;
+        }
+
+        if (!instance.is_object()) return;
+
+        // 子元素按 run_node 的顺序排列：先 properties（schema 顺序），再额外属性（实例顺序）
+        std::vector<parallel_plan::child> children;
+        for (uint32_t p = n.props_begin; p < n.props_end; ++p) {
+            auto it = instance.find(properties_[p].key);
+            if (it != instance.end()) children.push_back({properties_[p].node, &*it, escape_token(properties_[p].key)});
+        }
+        if (n.additional >= 0) {
+            const auto& known = known_keys_[n.known_keys];
+            for (auto it = instance.begin(); it != instance.end(); ++it) {
+                if (!known.count(it.key())) children.push_back({n.additional, &it.value(), escape_token(it.key())});
+            }
+        }
+
+        if (!large) {
+            // 小对象继续向下拆分，深处的大数组同样能并行
+            for (const auto& c : children) {
+                pointer += '/';
+                pointer += c.token;
+                plan_node(c.node, *c.value, pointer, plan);
+                pointer.resize(length);
+            }
+            return;
+        }
+
+        plan.children.push_back(std::move(children));
+        const auto& list = plan.children.back();
+        for (size_t begin = 0; begin < list.size(); begin += parallel_grain) {
+            size_t end = std::min(list.size(), begin + parallel_grain);
+            size_t segment = plan.reserve();
+            plan.tasks.push_back([this, &plan, &list, base = pointer, begin, end, segment] {
+                std::string path = base;
+                for (size_t i = begin; i < end; ++i) {
+                    path += '/';
+                    path += list[i].token;
+                    run_node(list[i].node, *list[i].value, path, plan.segments[segment]);
+                    path.resize(base.size());
+                }
+            });
+        }
+    }
+
+    void schema_program::run_parallel(const json& instance, std::vector<validation_error>& errors,
+                                      unsigned threads) const {
+        parallel_plan plan;
+        std::string pointer;
+        plan_node(root(), instance, pointer, plan);
+        utils::run_tasks(plan.tasks, threads);
+
+        // 哈希相同的元素再逐个比较，与 value_set 的判断一致
+        for (auto& u : plan.uniques) {
+            std::vector<size_t> order(u.hashes.size());
+            std::iota(order.begin(), order.end(), size_t{0});
+            std::sort(order.begin(), order.end(), [&u](size_t a, size_t b) { return u.hashes[a] < u.hashes[b]; });
+            bool duplicate = false;
+            for (size_t i = 0; i < order.size() && !duplicate; ++i) {
+                for (size_t j = i + 1; j < order.size() && u.hashes[order[j]] == u.hashes[order[i]]; ++j) {
+                    if ((*u.array)[order[i]] == (*u.array)[order[j]]) {
+                        duplicate = true;
+                        break;
+                    }
+                }
+            }
+            if (duplicate) {
+                error(u.pointer, *u.array, "items have to be unique for this array", plan.segments[u.segment]);
+            }
+        }
+
+        for (auto& segment : plan.segments) {
+            errors.insert(errors.end(), std::make_move_iterator(segment.begin()), std::make_move_iterator(segment.end()));
+        }
+    }
+
+}  // namespace config
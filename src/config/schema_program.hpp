@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "json_type.hpp"
+
+namespace config {
+
+    // 一条校验错误
+    struct validation_error {
+        std::string pointer;  // 实例中的 JSON Pointer
+        std::string value;    // 实例的 dump()
+        std::string message;
+    };
+
+    // 编译后的 schema 校验程序
+    // 常用关键字（type、enum、const、minimum/maximum、exclusiveMinimum/exclusiveMaximum、minLength/maxLength、
+    // pattern、minItems/maxItems、uniqueItems、items、required、properties、additionalProperties、
+    // minProperties/maxProperties、$ref）编译为平铺的节点数组：每个子 schema 一个节点，子 schema 之间以下标引用，
+    // 枚举预先放进哈希表，正则预先编译，属性按下标存放。校验时直接遍历 config::json，不再解释 schema 对象。
+    // 含其他关键字（format、oneOf、anyOf 等）的 schema 不编译，complete() 为 false，由完整的校验库处理。
+    class schema_program {
+    public:
+        // 按相对 schema 目录的路径读取 $ref 引用的文件
+        using document_loader = std::function<const json&(const std::string& relative_path)>;
+
+        schema_program(const json& schema, const document_loader& loader);
+
+        // 整个 schema 是否都已编译（否则不应使用 run）
+        bool complete() const { return complete_; }
+
+        // 第一个不支持的关键字（complete() 为 false 时）
+        const std::string& unsupported() const { return unsupported_; }
+
+        // 编译时通过 loader 读取的外部文件（相对 schema 目录的路径，含读取失败的），
+        // 这些文件变化后程序需要重新编译
+        const std::vector<std::string>& documents() const { return documents_; }
+
+        // 校验实例，错误按遍历顺序追加到 errors
+        void run(const json& instance, std::vector<validation_error>& errors) const;
+
+        // 与 run 结果完全相同（包括错误顺序），但大数组的元素和大对象的成员分块交给工作窃取线程池校验；
+        // 跨块的 uniqueItems 在各块算出元素哈希后统一判断。threads 为 0 时使用全部硬件线程
+        void run_parallel(const json& instance, std::vector<validation_error>& errors, unsigned threads = 0) const;
+
+        // 子元素达到此数量的数组和对象按此大小分块并行校验，更小的在当前线程校验
+        static constexpr size_t parallel_grain = 256;
+
+        // 校验 instance 在 node 处的子树，pointer 为其在文档中的位置（供并行校验按子树拆分）
+        void run_node(int32_t node, const json& instance, std::string& pointer, std::vector<validation_error>& errors) const;
+
+        // 只校验 instance 中与 path 匹配的子树，path 为 JSON Pointer，段为 * 时匹配任意成员或元素。
+        // 错误与完整校验在这些子树上的结果相同；返回匹配到的子树个数（schema 变化后只重新校验受影响的部分）
+        size_t run_path(const std::string& path, const json& instance, std::vector<validation_error>& errors) const;
+
+        // 节点信息（供并行校验决定如何拆分）
+        int32_t root() const { return 0; }
+        int32_t items_of(int32_t node) const { return nodes_[node].items; }
+        bool unique_items(int32_t node) const { return nodes_[node].unique_items; }
+
+    private:
+        struct node {
+            uint8_t types = 0;            // 允许的类型位集，0 表示不限
+            bool always_fail = false;     // false schema
+            bool unique_items = false;
+            // 包含与不包含边界分开存放，同时出现时两者都要满足
+            bool has_minimum = false, has_maximum = false;
+            bool has_exclusive_minimum = false, has_exclusive_maximum = false;
+            double minimum = 0, maximum = 0;
+            double exclusive_minimum_value = 0, exclusive_maximum_value = 0;
+            int64_t min_length = -1, max_length = -1;
+            int64_t min_items = -1, max_items = -1;
+            int64_t min_properties = -1, max_properties = -1;
+            int32_t enum_set = -1;        // enums_ 下标
+            int32_t const_value = -1;     // consts_ 下标
+            int32_t pattern = -1;         // patterns_ 下标
+            int32_t items = -1;           // 数组元素的节点
+            int32_t additional = -1;      // additionalProperties 的节点，-1 表示不限
+            uint32_t props_begin = 0, props_end = 0;        // properties_ 区间
+            uint32_t required_begin = 0, required_end = 0;  // required_ 区间
+            int32_t known_keys = -1;      // known_keys_ 下标（有 additionalProperties 时用于判断额外属性）
+        };
+
+        struct property {
+            std::string key;
+            int32_t node;
+        };
+
+        struct pattern {
+            std::string source;
+            std::regex regex;
+        };
+
+        // 按值（数值统一按 double）哈希，再逐个比较，与 json 的 == 语义一致
+        class value_set {
+        public:
+            void insert(const json& value);
+            bool contains(const json& value) const;
+        private:
+            std::unordered_map<uint64_t, std::vector<json>> buckets_;
+        };
+
+        struct parallel_plan;
+
+        // 节点自身的检查（不含子元素）；返回 false 表示类型不符，不再检查子元素。unique 为 false 时跳过 uniqueItems
+        bool check(const node& n, const json& instance, const std::string& pointer,
+                   std::vector<validation_error>& errors, bool unique) const;
+        size_t run_segments(int32_t index, const json& instance, const std::vector<std::string>& tokens, size_t depth,
+                            std::string& pointer, std::vector<validation_error>& errors) const;
+        void plan_node(int32_t index, const json& instance, std::string& pointer, parallel_plan& plan) const;
+
+        int32_t compile(const json& schema, const std::string& doc_path, const json& doc_root);
+        const json* resolve(const std::string& ref, std::string& doc_path, const json*& doc_root);
+        void fail(const std::string& keyword);
+
+        void error(const std::string& pointer, const json& instance, std::string message,
+                   std::vector<validation_error>& errors) const;
+
+        const document_loader* loader_ = nullptr;  // 仅在编译期间有效
+        std::unordered_map<const json*, int32_t> compiled_;  // 子 schema 地址 -> 节点（处理递归引用）
+
+        std::vector<node> nodes_;
+        std::vector<property> properties_;
+        std::vector<std::string> required_;
+        std::vector<value_set> enums_;
+        std::vector<json> consts_;
+        std::vector<pattern> patterns_;
+        std::vector<std::unordered_set<std::string>> known_keys_;
+        bool complete_ = true;
+        std::string unsupported_;
+        std::vector<std::string> documents_;
+    };
+
+    // 值哈希（数值按 double 计算，1 与 1.0 相同），用于 enum 和 uniqueItems
+    uint64_t value_hash(const json& value);
+
+}  // namespace config
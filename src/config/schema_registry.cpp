@@ -0,0 +1,194 @@
+#include "schema_registry.hpp"
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+namespace config {
+
+    namespace fs = std::filesystem;
+
+    namespace {
+
+        std::mutex registry_mutex;
+        std::shared_ptr<const registry_snapshot> current_registry;
+
+        std::string normalize_path(std::string path) {
+            while (!path.empty() && path[0] == '/') path.erase(0, 1);
+            return fs::path(path).lexically_normal().generic_string();
+        }
+
+        bool is_remote(const std::string& ref) {
+            return ref.find("://") != std::string::npos;
+        }
+
+        // 引用中的文件部分，转换为相对 schema 目录的路径；纯片段引用返回空串
+        std::string ref_file(const std::string& ref, const std::string& from) {
+            std::string file = ref.substr(0, ref.find('#'));
+            if (file.empty()) return "";
+            return normalize_path((fs::path(from).parent_path() / file).generic_string());
+        }
+
+        void collect_refs(const json& node, const std::string& from, std::set<std::string>& out) {
+            if (node.is_object()) {
+                for (auto it = node.begin(); it != node.end(); ++it) {
+                    if (it.key() == "$ref" && it.value().is_string()) {
+                        const auto& ref = it.value().get_ref<const std::string&>();
+                        if (!is_remote(ref)) {
+                            std::string file = ref_file(ref, from);
+                            if (!file.empty()) out.insert(file);
+                        }
+                    } else {
+                        collect_refs(it.value(), from, out);
+                    }
+                }
+            } else if (node.is_array()) {
+                for (const auto& item : node) collect_refs(item, from, out);
+            }
+        }
+
+        // "#/x" -> "from#/x"，"b.json#/x" -> "dir(from)/b.json#/x"
+        void normalize_refs(json& node, const std::string& from) {
+            if (node.is_object()) {
+                for (auto it = node.begin(); it != node.end(); ++it) {
+                    if (it.key() == "$ref" && it.value().is_string()) {
+                        std::string ref = it.value();
+                        if (is_remote(ref)) continue;
+                        auto hash = ref.find('#');
+                        std::string fragment = hash == std::string::npos ? "" : ref.substr(hash);
+                        std::string file = ref_file(ref, from);
+                        it.value() = (file.empty() ? from : file) + fragment;
+                    } else {
+                        normalize_refs(it.value(), from);
+                    }
+                }
+            } else if (node.is_array()) {
+                for (auto& item : node) normalize_refs(item, from);
+            }
+        }
+
+        std::optional<json> parse_file(const std::string& path) {
+            std::ifstream ifs(path);
+            if (!ifs.is_open()) return std::nullopt;
+            try {
+                json j;
+                ifs >> j;
+                return j;
+            } catch (const std::exception&) {
+                return std::nullopt;
+            }
+        }
+
+    }  // namespace
+
+    registry_snapshot::registry_snapshot(std::string schema_dir, json root)
+        : dir_(std::move(schema_dir)), root_(std::move(root)) {
+        std::set<std::string> pending;
+        collect_refs(root_, "", pending);
+
+        // 按层并行加载：每一层的文件同时读取解析，再收集它们引用的下一层文件
+        // 读取失败的文件留给校验器报告，这里不抛异常
+        while (!pending.empty()) {
+            std::vector<std::pair<std::string, std::future<std::optional<json>>>> wave;
+            for (const auto& rel : pending) {
+                std::string full = (fs::path(dir_) / rel).string();
+                wave.emplace_back(rel, std::async(std::launch::async, parse_file, full));
+            }
+            pending.clear();
+
+            std::set<std::string> next;
+            for (auto& [rel, future] : wave) {
+                auto parsed = future.get();
+                if (!parsed) continue;
+                collect_refs(*parsed, rel, next);
+                schema_document doc;
+                doc.normalized = *parsed;
+                normalize_refs(doc.normalized, rel);
+                doc.raw = std::move(*parsed);
+                documents_.emplace(rel, std::move(doc));
+            }
+            for (const auto& rel : next) {
+                if (!documents_.count(rel)) pending.insert(rel);
+            }
+        }
+    }
+
+    const registry_snapshot::schema_document& registry_snapshot::load(const std::string& relative_path) const {
+        std::string rel = normalize_path(relative_path);
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = documents_.find(rel);
+        if (it != documents_.end()) return it->second;
+
+        std::string full = (fs::path(dir_.empty() ? "." : dir_) / rel).string();
+        auto parsed = parse_file(full);
+        if (!parsed) {
+            throw std::invalid_argument("Could not open schema reference: " + relative_path + " (tried: " + full + ")");
+        }
+        schema_document doc;
+        doc.normalized = *parsed;
+        normalize_refs(doc.normalized, rel);
+        doc.raw = std::move(*parsed);
+        // std::map 插入不会使已有元素的引用失效
+        return documents_.emplace(rel, std::move(doc)).first->second;
+    }
+
+    const json& registry_snapshot::document(const std::string& relative_path) const {
+        return load(relative_path).raw;
+    }
+
+    std::vector<std::string> registry_snapshot::document_paths() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::string> paths;
+        for (const auto& entry : documents_) paths.push_back(entry.first);
+        return paths;
+    }
+
+    const json& registry_snapshot::resolve(const json& node) const {
+        const json* current = &node;
+        // 限制深度，避免循环引用
+        for (int depth = 0; depth < 32; ++depth) {
+            if (!current->is_object()) break;
+            auto it = current->find("$ref");
+            if (it == current->end() || !it->is_string()) break;
+
+            const auto& ref = it->get_ref<const std::string&>();
+            if (is_remote(ref)) break;
+            auto hash = ref.find('#');
+            std::string file = normalize_path(ref.substr(0, hash));
+            std::string fragment = hash == std::string::npos ? "" : ref.substr(hash + 1);
+
+            const json* doc = &root_;
+            if (!file.empty()) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto doc_it = documents_.find(file);
+                if (doc_it == documents_.end()) break;
+                doc = &doc_it->second.normalized;
+            }
+            try {
+                json::json_pointer target(fragment);
+                if (!doc->contains(target)) break;
+                current = &doc->at(target);
+            } catch (const std::exception&) {
+                break;
+            }
+        }
+        return *current;
+    }
+
+    void register_schema(const std::string& schema_path, const json& schema) {
+        // 在锁外构建新快照，构建完成后一次性替换；旧快照由仍持有它的调用方释放
+        auto snapshot = std::make_shared<const registry_snapshot>(fs::path(schema_path).parent_path().string(), schema);
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        current_registry = std::move(snapshot);
+    }
+
+    std::shared_ptr<const registry_snapshot> current_schema_registry() {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        if (!current_registry) current_registry = std::make_shared<const registry_snapshot>("", json());
+        return current_registry;
+    }
+
+}  // namespace config
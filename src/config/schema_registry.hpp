@@ -0,0 +1,56 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "json_type.hpp"
+
+namespace config {
+
+    // 一次 register_schema 的结果：根 schema、所在目录及其引用的外部文档。
+    // 快照创建后只增不改（按需读取的文档追加进来，已有文档不会被替换或删除），
+    // 返回的引用在快照存活期间一直有效；注册新 schema 时整体换成新快照，持有旧快照的调用方不受影响。
+    class registry_snapshot {
+    public:
+        // 并行预加载 root 中（以及被引用文件中）引用的外部文件；读取失败的文件留给校验器报告
+        registry_snapshot(std::string schema_dir, json root);
+
+        // schema 所在目录（未注册 schema 时为空）
+        const std::string& dir() const { return dir_; }
+        const json& root() const { return root_; }
+
+        // 按相对 schema 目录的路径获取引用文档（原始内容，供校验器使用）
+        // 未预加载的文件会在此时读取并缓存，无法读取或解析时抛异常
+        const json& document(const std::string& relative_path) const;
+
+        // 已加载的引用文档（相对 schema 目录的路径，按路径排序）
+        std::vector<std::string> document_paths() const;
+
+        // 节点含 $ref 时返回最终的引用目标，否则（或无法解析时）返回节点本身
+        const json& resolve(const json& node) const;
+
+    private:
+        struct schema_document {
+            json raw;         // 原样内容，交给校验器（它自行按文档位置解析引用）
+            json normalized;  // $ref 已改写为相对 schema 目录的形式，供 resolve 使用
+        };
+
+        const schema_document& load(const std::string& relative_path) const;
+
+        std::string dir_;
+        json root_;
+        mutable std::mutex mutex_;
+        mutable std::map<std::string, schema_document> documents_;  // 相对 schema 目录的路径 -> 文档
+    };
+
+    // 登记根 schema，并从 schema 所在目录出发并行读取、解析所有外部 $ref 引用的文件
+    // （包括被引用文件中的引用），生成新快照后替换当前快照。每个文件只解析一次，结果常驻快照中。
+    void register_schema(const std::string& schema_path, const json& schema);
+
+    // 当前快照（register_schema 之前为空快照）。需要在多次调用间保持一致或长期引用其中节点时，
+    // 调用方应持有同一个快照，而不是反复获取
+    std::shared_ptr<const registry_snapshot> current_schema_registry();
+
+}  // namespace config
@@ -0,0 +1,161 @@
+#include "schema_watcher.hpp"
+#include "config_file.hpp"
+#include "layered_config.hpp"
+#include "schema_diff.hpp"
+#include "schema_registry.hpp"
+#include "tree_hash.hpp"
+#include "validator.hpp"
+#include "../utils/fs.hpp"
+#include "../utils/task_pool.hpp"
+#include "../utils/trace.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace config {
+
+    namespace fs = std::filesystem;
+
+    namespace {
+
+        bool read_file(const std::string& path, std::string& content) {
+            std::ifstream ifs(path, std::ios::binary);
+            if (!ifs.is_open()) return false;
+            std::ostringstream oss;
+            oss << ifs.rdbuf();
+            content = oss.str();
+            return true;
+        }
+
+    }  // namespace
+
+    schema_watcher::schema_watcher(std::string schema_path, std::string configs_dir, json current, callback on_reload,
+                                   std::chrono::milliseconds interval)
+        : schema_path_(std::move(schema_path)), configs_dir_(std::move(configs_dir)), current_(std::move(current)),
+          on_reload_(std::move(on_reload)), interval_(interval) {
+        // 以启动时的文件内容为基准，之后只在内容真正变化时重新加载
+        schema_dir_ = fs::path(schema_path_).parent_path().string();
+        std::error_code ec;
+        mtime_ = static_cast<int64_t>(fs::last_write_time(schema_path_, ec).time_since_epoch().count());
+        size_ = static_cast<uint64_t>(fs::file_size(schema_path_, ec));
+        std::string content;
+        if (read_file(schema_path_, content)) hash_ = hash_bytes(content);
+        watch_documents(current_);
+        thread_ = std::thread([this] { loop(); });
+    }
+
+    schema_watcher::~schema_watcher() {
+        cancel_ = true;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        if (thread_.joinable()) thread_.join();
+    }
+
+    std::unique_lock<std::mutex> schema_watcher::pause() {
+        cancel_ = true;
+        std::unique_lock<std::mutex> lock(reload_mutex_);
+        cancel_ = false;
+        return lock;
+    }
+
+    void schema_watcher::watch_documents(const json& schema) {
+        // 借助注册表快照的预加载找出（递归）引用的外部文件；这个快照只用于收集路径，不会被安装
+        documents_ = registry_snapshot(schema_dir_, schema).document_paths();
+        documents_stamp_ = utils::filesystem::files_stamp(schema_dir_, documents_);
+    }
+
+    void schema_watcher::loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!wake_.wait_for(lock, interval_, [this] { return stop_; })) {
+            lock.unlock();
+            try {
+                poll();
+            } catch (const std::exception&) {
+                // 单次轮询失败（如文件正在被替换）时等下一轮
+            }
+            lock.lock();
+        }
+    }
+
+    void schema_watcher::poll() {
+        std::lock_guard<std::mutex> guard(reload_mutex_);
+        // 先比较修改时间和大小，变化后再读内容：编辑器保存时可能只更新时间，内容相同则不重新加载
+        std::error_code ec;
+        auto mtime = static_cast<int64_t>(fs::last_write_time(schema_path_, ec).time_since_epoch().count());
+        if (ec) return;
+        auto size = static_cast<uint64_t>(fs::file_size(schema_path_, ec));
+        if (ec) return;
+        const bool documents_changed = utils::filesystem::files_stamp(schema_dir_, documents_) != documents_stamp_;
+        if (mtime == mtime_ && size == size_ && !documents_changed) return;
+
+        std::string content;
+        if (!read_file(schema_path_, content)) return;
+        uint64_t hash = hash_bytes(content);
+        if (hash == hash_ && !documents_changed) {
+            mtime_ = mtime;
+            size_ = size;
+            return;
+        }
+
+        schema_reload result;
+        if (!reload(content, documents_changed, result)) return;  // 被取消：基准不变，下一轮重新检测
+        mtime_ = mtime;
+        size_ = size;
+        hash_ = hash;
+        on_reload_(std::move(result));
+    }
+
+    bool schema_watcher::reload(const std::string& content, bool documents_changed, schema_reload& result) {
+        TRACE_SCOPE("reload_schema", "config", schema_path_);
+        try {
+            result.schema = json::parse(content);
+        } catch (const std::exception& e) {
+            result.error = "Failed to parse schema JSON: " + std::string(e.what());
+            // 同一次变化只报告一次，引用文件的指纹也随之更新
+            documents_stamp_ = utils::filesystem::files_stamp(schema_dir_, documents_);
+            return true;
+        }
+
+        // 外部引用文件的内容不在根 schema 中，无法比较出受影响的位置，只能整体重新校验
+        result.changed = documents_changed ? std::vector<std::string>{""} : changed_instance_paths(current_, result.schema);
+        if (!result.changed.empty()) {
+            // 每个配置文件一个任务：读取并只校验受影响的子树，结果按文件名顺序汇总
+            auto files = utils::filesystem::list_json_files(configs_dir_);
+            std::vector<std::vector<validation_error>> errors(files.size());
+            std::vector<char> affected(files.size(), 0);
+            std::vector<std::function<void()>> tasks;
+            for (size_t i = 0; i < files.size(); ++i) {
+                tasks.push_back([&, i] {
+                    if (cancel_) return;
+                    std::string path = (fs::path(configs_dir_) / files[i]).string();
+                    try {
+                        // 分层配置校验合并后的结果
+                        json config = load_config(path);
+                        if (is_layered(config)) config = load_merged_config(path);
+                        bool hit = false;
+                        errors[i] = validate_paths(config, result.schema, schema_dir_, result.changed, &hit);
+                        affected[i] = hit;
+                    } catch (const std::exception& e) {
+                        errors[i].push_back({"", "", e.what()});
+                        affected[i] = 1;
+                    }
+                });
+            }
+            utils::run_tasks(tasks);
+            if (cancel_) return false;
+
+            for (size_t i = 0; i < files.size(); ++i) {
+                if (!affected[i]) continue;
+                ++result.affected;
+                if (!errors[i].empty()) result.failures.emplace_back(files[i], std::move(errors[i]));
+            }
+        }
+        current_ = result.schema;
+        watch_documents(current_);
+        return true;
+    }
+
+}  // namespace config
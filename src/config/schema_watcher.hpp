@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "json_type.hpp"
+#include "schema_program.hpp"
+
+namespace config {
+
+    // 一次 schema 热加载的结果
+    struct schema_reload {
+        std::string error;                  // 非空表示新文件无法读取或解析，其余字段无效，继续使用旧 schema
+        json schema;                        // 新 schema
+        std::vector<std::string> changed;   // 校验结果可能变化的实例位置（见 changed_instance_paths）
+        size_t affected = 0;                // 含受影响子树、因此重新校验过的配置文件数
+        std::vector<std::pair<std::string, std::vector<validation_error>>> failures;  // 未通过的配置：文件名 -> 错误
+    };
+
+    // 在后台线程中轮询 schema 文件，内容变化后重新解析、编译，并只对 configs_dir 中受影响的配置、
+    // 受影响的子树重新校验（多个配置并行），然后在该线程中调用 on_reload。
+    // 回调不应直接修改界面状态，而应把结果投递到界面线程。析构时停止线程。
+    // $ref 引用的外部文件也按修改时间和大小监视；它们变化时无法只比较根 schema，所有配置整体重新校验。
+    class schema_watcher {
+    public:
+        using callback = std::function<void(schema_reload)>;
+
+        schema_watcher(std::string schema_path, std::string configs_dir, json current, callback on_reload,
+                       std::chrono::milliseconds interval = std::chrono::milliseconds(1000));
+        ~schema_watcher();
+
+        schema_watcher(const schema_watcher&) = delete;
+        schema_watcher& operator=(const schema_watcher&) = delete;
+
+        // 暂停监视：取消正在进行的重新校验并等它退出，返回的锁存活期间不会开始新的重新加载。
+        // 界面线程安装 schema 前调用，避免与后台校验同时替换注册表和校验缓存；被取消的变化在恢复后重新检测
+        std::unique_lock<std::mutex> pause();
+
+    private:
+        void loop();
+        void poll();
+        bool reload(const std::string& content, bool documents_changed, schema_reload& result);
+        void watch_documents(const json& schema);
+
+        std::string schema_path_;
+        std::string configs_dir_;
+        json current_;
+        callback on_reload_;
+        std::chrono::milliseconds interval_;
+
+        std::string schema_dir_;
+        int64_t mtime_ = 0;
+        uint64_t size_ = 0;
+        uint64_t hash_ = 0;
+        std::vector<std::string> documents_;  // schema 引用的外部文件（相对 schema 目录）
+        uint64_t documents_stamp_ = 0;
+
+        std::mutex reload_mutex_;  // 轮询和重新加载期间持有
+        std::atomic<bool> cancel_{false};
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        bool stop_ = false;
+        std::thread thread_;
+    };
+
+}  // namespace config
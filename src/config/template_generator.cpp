@@ -1,53 +1,139 @@
 #include "template_generator.hpp"
+#include "schema_registry.hpp"
+#include "tree_hash.hpp"
+#include "../utils/trace.hpp"
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace config {
 
-    json generate_default_config(const json& schema) {
-        if (!schema.contains("type"))
-            return nullptr;
-
-        std::string type = schema["type"];
-
-        if (type == "object") {
-            json result = json::object();
-            if (schema.contains("properties")) {
-                for (auto it = schema["properties"].begin(); it != schema["properties"].end(); ++it) {
-                    const std::string& key = it.key();
-                    const json& subschema = it.value();
-                    result[key] = generate_default_config(subschema);
+    namespace {
+
+        // 一次生成过程的状态。生成期间调用方的 schema 和注册表快照都存活，子节点可以按地址记忆，
+        // 同一定义（$ref 解析后的节点）只生成一次；in_progress 是正在展开的节点，递归引用回到其中时停止展开
+        struct generation {
+            const registry_snapshot& registry;
+            std::unordered_map<const json*, json> memo;
+            std::unordered_set<const json*> in_progress;
+        };
+
+        // 跨调用的缓存：按 schema 内容哈希分桶，命中后再比较内容，条目自带 schema 副本，
+        // 不依赖调用方对象的地址和生存期。$ref 按注册表解析，缓存只对生成时的快照有效
+        struct cache_entry {
+            json schema;
+            json value;
+        };
+        std::mutex cache_mutex;
+        std::shared_ptr<const registry_snapshot> cache_registry;
+        std::unordered_multimap<uint64_t, cache_entry> default_cache;
+
+        const json& generate_node(generation& gen, const json& node);
+
+        json build_default(generation& gen, const json& schema) {
+            if (!schema.contains("type"))
+                return nullptr;
+
+            std::string type = schema["type"];
+
+            if (type == "object") {
+                if (schema.contains("default"))
+                    return schema["default"];
+                json result = json::object();
+                if (schema.contains("properties")) {
+                    for (auto it = schema["properties"].begin(); it != schema["properties"].end(); ++it) {
+                        result[it.key()] = generate_node(gen, it.value());
+                    }
+                }
+                return result;
+            } else if (schema.contains("enum")){
+                if (schema["enum"].size() > 0)
+                    return schema["enum"][0];
+                return nullptr;
+            } else if (type == "array") {
+                if (schema.contains("default"))
+                    return schema["default"];
+                json arr = json::array();
+                int count = 0;
+                if (schema.contains("minItems"))
+                    count = schema["minItems"];
+                if (count > 0) {
+                    const json& item = schema.contains("items") ? generate_node(gen, schema["items"]) : json();
+                    for (int i = 0; i < count; ++i) {
+                        arr.push_back(item);
+                    }
                 }
+                return arr;
+            } else if (type == "string") {
+                if (schema.contains("default"))
+                    return schema["default"];
+                return "";
+            } else if (type == "integer" || type == "number") {
+                if (schema.contains("default"))
+                    return schema["default"];
+                if (schema.contains("minimum"))
+                    return schema["minimum"];
+                return 0;
+            } else if (type == "boolean") {
+                if (schema.contains("default"))
+                    return schema["default"];
+                return false;
             }
-            return result;
-        } else if (schema.contains("enum")){
-            if (schema["enum"].size() > 0)
-                return schema["enum"][0];
-            return nullptr;
-        } else if (type == "array") {
-            json arr = json::array();
-            int count = 0;
-            if (schema.contains("minItems"))
-                count = schema["minItems"];
-            for (int i = 0; i < count; ++i) {
-                arr.push_back(generate_default_config(schema["items"]));
+
+            return nullptr; // 不支持或未定义类型
+        }
+
+        const json& generate_node(generation& gen, const json& node) {
+            static const json null_value;
+            const json& schema = gen.registry.resolve(node);
+            auto it = gen.memo.find(&schema);
+            if (it != gen.memo.end()) return it->second;
+            // 递归的 $ref（如树形结构）在第二次遇到同一节点时以 null 结束
+            if (!gen.in_progress.insert(&schema).second) return null_value;
+            json value = build_default(gen, schema);
+            gen.in_progress.erase(&schema);
+            return gen.memo.emplace(&schema, std::move(value)).first->second;
+        }
+
+    }  // namespace
+
+    json generate_default_config(const json& schema) {
+        TRACE_SCOPE("generate_default_config");
+        auto registry = current_schema_registry();
+        const uint64_t hash = hash_json(schema);
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex);
+            if (cache_registry == registry) {
+                auto [first, last] = default_cache.equal_range(hash);
+                for (auto it = first; it != last; ++it) {
+                    // 在锁内复制，避免与 clear_default_config_cache 竞争
+                    if (it->second.schema == schema) return it->second.value;
+                }
             }
-            return arr;
-        } else if (type == "string") {
-            if (schema.contains("default"))
-                return schema["default"];
-            return "";
-        } else if (type == "integer" || type == "number") {
-            if (schema.contains("default"))
-                return schema["default"];
-            if (schema.contains("minimum"))
-                return schema["minimum"];
-            return 0;
-        } else if (type == "boolean") {
-            if (schema.contains("default"))
-                return schema["default"];
-            return false;
         }
 
-        return nullptr; // 不支持或未定义类型
+        // 生成过程中不持锁；并发生成同一 schema 时保留先插入的结果
+        generation gen{*registry, {}, {}};
+        json value = generate_node(gen, schema);
+
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        if (cache_registry != registry) {
+            default_cache.clear();
+            cache_registry = registry;
+        }
+        auto [first, last] = default_cache.equal_range(hash);
+        for (auto it = first; it != last; ++it) {
+            if (it->second.schema == schema) return value;
+        }
+        default_cache.emplace(hash, cache_entry{schema, value});
+        return value;
+    }
+
+    void clear_default_config_cache() {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        default_cache.clear();
+        cache_registry.reset();
     }
 
 }  // namespace config
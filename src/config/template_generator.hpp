@@ -1,12 +1,15 @@
 #pragma once
 
-#include <nlohmann/json.hpp>
+#include "json_type.hpp"
 
 namespace config {
 
-    using json = nlohmann::ordered_json;
-
     // 根据 schema 递归生成默认配置模板
+    // 结果按 schema 内容缓存（$ref 按当前注册表快照解析），重复调用只复制缓存值；
+    // 递归引用的定义在第二次出现处生成 null
     json generate_default_config(const json& schema);
 
+    // 清空默认值缓存
+    void clear_default_config_cache();
+
 }  // namespace config
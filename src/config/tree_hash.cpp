@@ -0,0 +1,194 @@
+#include "tree_hash.hpp"
+#include <cstring>
+
+namespace config {
+
+    namespace {
+
+        constexpr uint64_t fnv_offset = 1469598103934665603ULL;
+        constexpr uint64_t fnv_prime = 1099511628211ULL;
+
+        uint64_t fnv1a(uint64_t h, const void* data, size_t len) {
+            auto p = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < len; ++i) {
+                h ^= p[i];
+                h *= fnv_prime;
+            }
+            return h;
+        }
+
+        uint64_t mix(uint64_t h, uint64_t v) {
+            return fnv1a(h, &v, sizeof(v));
+        }
+
+        uint64_t hash_string(const std::string& s) {
+            return fnv1a(fnv_offset, s.data(), s.size());
+        }
+
+        // 基本类型按值计算；非负整数不区分有无符号（dump() 结果相同）
+        uint64_t hash_scalar(const json& j) {
+            if (j.is_number_integer() && j.get<int64_t>() >= 0) {
+                return mix(mix(fnv_offset, static_cast<uint64_t>(json::value_t::number_unsigned)), j.get<uint64_t>());
+            }
+            uint64_t h = mix(fnv_offset, static_cast<uint64_t>(j.type()));
+            switch (j.type()) {
+                case json::value_t::string: {
+                    const auto& s = j.get_ref<const std::string&>();
+                    return fnv1a(h, s.data(), s.size());
+                }
+                case json::value_t::boolean:
+                    return mix(h, j.get<bool>() ? 1 : 0);
+                case json::value_t::number_integer:
+                    return mix(h, static_cast<uint64_t>(j.get<int64_t>()));
+                case json::value_t::number_unsigned:
+                    return mix(h, j.get<uint64_t>());
+                case json::value_t::number_float: {
+                    double d = j.get<double>();
+                    uint64_t bits;
+                    std::memcpy(&bits, &d, sizeof(bits));
+                    return mix(h, bits);
+                }
+                default:
+                    return h;
+            }
+        }
+
+        // json_pointer 单段转义：~ -> ~0, / -> ~1
+        std::string escape_token(const std::string& token) {
+            std::string out;
+            out.reserve(token.size());
+            for (char c : token) {
+                if (c == '~') out += "~0";
+                else if (c == '/') out += "~1";
+                else out += c;
+            }
+            return out;
+        }
+
+        // 容器的哈希由子节点哈希组合，child_hash 负责取子节点哈希（可能命中缓存）
+        template <typename ChildHash>
+        uint64_t combine_children(const json& node, const std::string& key, ChildHash&& child_hash) {
+            uint64_t h = mix(fnv_offset, static_cast<uint64_t>(node.type()));
+            h = mix(h, node.size());
+            if (node.is_object()) {
+                for (auto it = node.begin(); it != node.end(); ++it) {
+                    h = mix(h, hash_string(it.key()));
+                    h = mix(h, child_hash(it.value(), key + "/" + escape_token(it.key())));
+                }
+            } else {
+                size_t i = 0;
+                for (const auto& item : node) {
+                    h = mix(h, child_hash(item, key + "/" + std::to_string(i++)));
+                }
+            }
+            return h;
+        }
+
+        uint64_t hash_uncached(const json& node) {
+            if (!node.is_structured()) return hash_scalar(node);
+            return combine_children(node, "", [](const json& child, const std::string&) {
+                return hash_uncached(child);
+            });
+        }
+
+    }  // namespace
+
+    uint64_t hash_json(const json& j) {
+        return hash_uncached(j);
+    }
+
+    uint64_t hash_bytes(const std::string& data) {
+        return hash_string(data);
+    }
+
+    tree_hash::tree_hash(const json& doc) : doc_(doc) {}
+
+    uint64_t tree_hash::compute(const json& node, const std::string& key) {
+        auto it = cache_.find(key);
+        if (it != cache_.end()) return it->second;
+
+        uint64_t h;
+        if (node.is_structured()) {
+            h = combine_children(node, key, [this](const json& child, const std::string& child_key) {
+                return compute(child, child_key);
+            });
+        } else {
+            h = hash_scalar(node);
+        }
+        cache_.emplace(key, h);
+        return h;
+    }
+
+    uint64_t tree_hash::root() {
+        return compute(doc_, "");
+    }
+
+    uint64_t tree_hash::at(const json::json_pointer& ptr) {
+        if (!doc_.contains(ptr)) return 0;
+        return compute(doc_.at(ptr), ptr.to_string());
+    }
+
+    void tree_hash::invalidate(const json::json_pointer& ptr) {
+        std::string key = ptr.to_string();
+
+        // 子树（包括 ptr 自身）
+        std::string prefix = key + "/";
+        cache_.erase(key);
+        for (auto it = cache_.lower_bound(prefix); it != cache_.end() && it->first.compare(0, prefix.size(), prefix) == 0;) {
+            it = cache_.erase(it);
+        }
+
+        // 所有祖先
+        json::json_pointer parent = ptr;
+        while (!parent.empty()) {
+            parent = parent.parent_pointer();
+            cache_.erase(parent.to_string());
+        }
+    }
+
+    void tree_hash::mark_clean() {
+        root();
+        clean_ = cache_;
+    }
+
+    bool tree_hash::dirty() {
+        auto it = clean_.find("");
+        return it == clean_.end() || it->second != root();
+    }
+
+    bool tree_hash::is_dirty(const json::json_pointer& ptr) {
+        auto it = clean_.find(ptr.to_string());
+        if (!doc_.contains(ptr)) return it != clean_.end();
+        return it == clean_.end() || it->second != at(ptr);
+    }
+
+    std::vector<json::json_pointer> tree_hash::dirty_paths() {
+        std::vector<json::json_pointer> out;
+        root();
+        collect_dirty(doc_, "", out);
+        return out;
+    }
+
+    // 返回该节点是否脏；若脏但无法归因到某个子节点（如删键、类型变化），则报告节点本身
+    bool tree_hash::collect_dirty(const json& node, const std::string& key, std::vector<json::json_pointer>& out) {
+        auto clean = clean_.find(key);
+        if (clean != clean_.end() && clean->second == compute(node, key)) return false;
+
+        bool child_dirty = false;
+        if (clean != clean_.end() && node.is_structured()) {
+            if (node.is_object()) {
+                for (auto it = node.begin(); it != node.end(); ++it) {
+                    child_dirty |= collect_dirty(it.value(), key + "/" + escape_token(it.key()), out);
+                }
+            } else {
+                size_t i = 0;
+                for (const auto& item : node) {
+                    child_dirty |= collect_dirty(item, key + "/" + std::to_string(i++), out);
+                }
+            }
+        }
+        if (!child_dirty) out.emplace_back(key);
+        return true;
+    }
+
+}  // namespace config
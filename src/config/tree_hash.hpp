@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "json_type.hpp"
+
+namespace config {
+
+    // 计算任意 json 的内容哈希（对象按键顺序参与计算，与 dump() 输出一致）
+    uint64_t hash_json(const json& j);
+
+    // 计算字节串的哈希（FNV-1a）
+    uint64_t hash_bytes(const std::string& data);
+
+    // 配置文档的 Merkle 子树哈希
+    // 每个节点的哈希由其子节点哈希组合而成并缓存，修改某处后只需让该子树及其祖先失效，
+    // 重新计算时未修改的兄弟子树直接复用缓存。
+    class tree_hash {
+    public:
+        explicit tree_hash(const json& doc);
+
+        // 整个文档的哈希
+        uint64_t root();
+
+        // 指定子树的哈希
+        uint64_t at(const json::json_pointer& ptr);
+
+        // ptr 处的值被修改（或被删除、插入）后调用：清除其子树及所有祖先的缓存
+        void invalidate(const json::json_pointer& ptr);
+
+        // 将当前内容记为基线（加载或保存后调用，基线即磁盘上的内容）
+        void mark_clean();
+
+        // 当前内容是否与基线不同
+        bool dirty();
+
+        // 指定子树是否与基线不同
+        bool is_dirty(const json::json_pointer& ptr);
+
+        // 与基线相比发生变化的最小子树
+        std::vector<json::json_pointer> dirty_paths();
+
+    private:
+        uint64_t compute(const json& node, const std::string& key);
+        bool collect_dirty(const json& node, const std::string& key, std::vector<json::json_pointer>& out);
+
+        const json& doc_;
+        std::map<std::string, uint64_t> cache_;  // json_pointer 字符串 -> 子树哈希
+        std::map<std::string, uint64_t> clean_;  // 基线时的子树哈希
+    };
+
+}  // namespace config
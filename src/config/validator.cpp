@@ -1,21 +1,28 @@
 #include "validator.hpp"
+#include "schema_registry.hpp"
+#include "schema_program.hpp"
+#include "tree_hash.hpp"
+#include "../utils/fs.hpp"
+#include "../utils/trace.hpp"
 #include <nlohmann/json-schema.hpp>
+#include <cstdlib>
+#include <filesystem>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <vector>
 #include <stdexcept>
 
 namespace config {
 
-    // schema loader：支持本地路径加载
-    static void loader(const nlohmann::json_uri &uri, nlohmann::json &schema) {
-        std::string filename = "./" + uri.path();
-        std::ifstream lf(filename);
-        if (!lf.good()) {
-            throw std::invalid_argument("Could not open schema from URI: " + uri.url() +
-                                        " (tried: " + filename + ")");
+    static std::string error_report(const std::vector<std::string>& errors) {
+        std::ostringstream oss;
+        for (size_t i = 0; i < errors.size(); ++i) {
+            oss << "[" << i + 1 << "] " << errors[i] << "\n";
         }
-        lf >> schema;
+        return oss.str();
     }
 
     // 自定义错误处理器
@@ -32,33 +39,177 @@ namespace config {
         }
 
         bool has_errors() const { return !errors.empty(); }
-        std::string get_error_report() const {
-            std::ostringstream oss;
-            for (size_t i = 0; i < errors.size(); ++i) {
-                oss << "[" << i + 1 << "] " << errors[i] << "\n";
-            }
-            return oss.str();
-        }
+        std::string get_error_report() const { return error_report(errors); }
 
     private:
         std::vector<std::string> errors;
     };
 
+    static void run_library(const json &config, const json &schema,
+                            nlohmann::json_schema::schema_loader schema_loader) {
+        nlohmann::json_schema::json_validator validator(std::move(schema_loader),
+                                                        nlohmann::json_schema::default_string_format_check);
+        validator.set_root_schema(nlohmann::json(schema));
+
+        custom_error_handler err;
+        validator.validate(nlohmann::json(config), err);
+
+        if (err.has_errors()) {
+            throw std::runtime_error("Config validation failed:\n" + err.get_error_report());
+        }
+    }
+
+    static bool use_program() {
+        static const bool enabled = [] {
+            const char* mode = std::getenv("CONFIGMANAGER_VALIDATOR");
+            return !(mode && std::string(mode) == "library");
+        }();
+        return enabled;
+    }
+
+    // 编译好的校验程序，按 schema 目录和 schema 内容哈希缓存；同时记录编译时引用的外部文件的指纹，
+    // 这些文件被编辑后（根 schema 不变）缓存的程序失效，重新编译
+    struct cached_program {
+        std::shared_ptr<const schema_program> program;
+        uint64_t documents_stamp = 0;
+    };
+    static std::mutex programs_mutex;
+    static std::map<std::string, cached_program> programs;
+
+    static std::shared_ptr<const schema_program> program_for(const json &schema, const std::string &schema_dir,
+                                                             const schema_program::document_loader &load) {
+        std::string key = schema_dir + "\n" + std::to_string(hash_json(schema));
+        cached_program cached;
+        {
+            std::lock_guard<std::mutex> lock(programs_mutex);
+            auto it = programs.find(key);
+            if (it != programs.end()) cached = it->second;
+        }
+        uint64_t stamp = 0;
+        if (cached.program) {
+            stamp = utils::filesystem::files_stamp(schema_dir, cached.program->documents());
+            if (stamp == cached.documents_stamp) return cached.program;
+        }
+        TRACE_SCOPE("compile_schema", "config", schema_dir);
+        auto program = std::make_shared<const schema_program>(schema, load);
+        // 引用的文件不变时沿用编译前取的指纹：编译期间文件又被修改，下次查找会发现指纹不符
+        if (!cached.program || program->documents() != cached.program->documents()) {
+            stamp = utils::filesystem::files_stamp(schema_dir, program->documents());
+        }
+        std::lock_guard<std::mutex> lock(programs_mutex);
+        programs[key] = {program, stamp};
+        return program;
+    }
+
+    // 编译后的程序能处理整个 schema 时由它校验并返回 true，否则返回 false
+    static bool run_program(const json &config, const json &schema, const std::string &schema_dir,
+                            const schema_program::document_loader &load) {
+        if (!use_program()) return false;
+        auto program = program_for(schema, schema_dir, load);
+        if (!program->complete()) return false;
+
+        std::vector<validation_error> errors;
+        program->run_parallel(config, errors);
+        if (!errors.empty()) {
+            std::vector<std::string> lines;
+            for (const auto &e : errors) {
+                lines.push_back("Validation error at " + e.pointer + " (value: " + e.value + "): " + e.message);
+            }
+            throw std::runtime_error("Config validation failed:\n" + error_report(lines));
+        }
+        return true;
+    }
+
+    void clear_validation_cache() {
+        std::lock_guard<std::mutex> lock(programs_mutex);
+        programs.clear();
+    }
+
     // 验证接口
-    void validate_config(const nlohmann::json &config, const nlohmann::json &schema) {
+    void validate_config(const json &config, const json &schema) {
+        TRACE_SCOPE("validate_config");
         if (schema.is_null() || !schema.is_object()) {
             throw std::invalid_argument("Invalid or empty schema provided");
         }
+        // 整个校验过程使用同一个注册表快照，期间重新注册 schema 不影响已取得的文档
+        auto registry = current_schema_registry();
+        auto load = [&registry](const std::string &rel) -> const json & { return registry->document(rel); };
+        if (run_program(config, schema, registry->dir(), load)) return;
+        // schema loader：从注册表快照获取（相对 schema 所在目录，已解析的文档不会重复读取）
+        run_library(config, schema, [&registry](const nlohmann::json_uri &uri, nlohmann::json &doc) {
+            try {
+                doc = registry->document(uri.path());
+            } catch (const std::exception &e) {
+                throw std::invalid_argument("Could not open schema from URI: " + uri.url() + ": " + e.what());
+            }
+        });
+    }
 
-        nlohmann::json_schema::json_validator validator(loader, nlohmann::json_schema::default_string_format_check);
-        validator.set_root_schema(schema);
+    // 相对 schema_dir 读取 $ref 引用的文件（不经过 schema 注册表）；读取的文件只在本对象中保留
+    class directory_loader {
+    public:
+        explicit directory_loader(const std::string &schema_dir) : dir_(schema_dir) {}
 
-        custom_error_handler err;
-        validator.validate(config, err);
+        const json &operator()(const std::string &rel) {
+            auto it = documents_.find(rel);
+            if (it != documents_.end()) return it->second;
+            std::ifstream ifs(std::filesystem::path(dir_) / rel);
+            if (!ifs.is_open()) {
+                throw std::invalid_argument("Could not open schema reference: " + rel);
+            }
+            json doc;
+            ifs >> doc;
+            return documents_.emplace(rel, std::move(doc)).first->second;
+        }
 
-        if (err.has_errors()) {
-            throw std::runtime_error("Config validation failed:\n" + err.get_error_report());
+    private:
+        std::string dir_;
+        std::map<std::string, json> documents_;
+    };
+
+    void validate_config(const json &config, const json &schema, const std::string &schema_dir) {
+        TRACE_SCOPE("validate_config", "config", schema_dir);
+        if (schema.is_null() || !schema.is_object()) {
+            throw std::invalid_argument("Invalid or empty schema provided");
+        }
+        directory_loader documents(schema_dir);
+        auto load = [&documents](const std::string &rel) -> const json & { return documents(rel); };
+        if (run_program(config, schema, schema_dir, load)) return;
+        run_library(config, schema, [&schema_dir](const nlohmann::json_uri &uri, nlohmann::json &doc) {
+            std::string rel = uri.path();
+            while (!rel.empty() && rel[0] == '/') rel.erase(0, 1);
+            std::ifstream ifs(std::filesystem::path(schema_dir) / rel);
+            if (!ifs.is_open()) {
+                throw std::invalid_argument("Could not open schema from URI: " + uri.url());
+            }
+            ifs >> doc;
+        });
+    }
+
+    std::vector<validation_error> validate_paths(const json &config, const json &schema, const std::string &schema_dir,
+                                                 const std::vector<std::string> &paths, bool *affected) {
+        TRACE_SCOPE("validate_paths", "config", schema_dir);
+        std::vector<validation_error> errors;
+        directory_loader documents(schema_dir);
+        auto load = [&documents](const std::string &rel) -> const json & { return documents(rel); };
+        std::shared_ptr<const schema_program> program;
+        if (use_program()) program = program_for(schema, schema_dir, load);
+
+        if (program && program->complete()) {
+            size_t matched = 0;
+            for (const auto &path : paths) matched += program->run_path(path, config, errors);
+            if (affected) *affected = matched > 0;
+            return errors;
+        }
+
+        // 编译程序处理不了的 schema 只能完整校验，错误报告作为一条返回
+        if (affected) *affected = true;
+        try {
+            validate_config(config, schema, schema_dir);
+        } catch (const std::exception &e) {
+            errors.push_back({"", "", e.what()});
         }
+        return errors;
     }
 
 } // namespace config
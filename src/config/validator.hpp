@@ -1,10 +1,27 @@
 #pragma once
 
-#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+#include "json_type.hpp"
+#include "schema_program.hpp"
 
 namespace config {
     
     // 验证配置json是否符合schema，验证失败会抛异常
-    void validate_config(const nlohmann::json& config, const nlohmann::json& schema);
+    // schema 只用到常用关键字时走编译后的校验程序（见 schema_program），否则使用完整的校验库；
+    // 环境变量 CONFIGMANAGER_VALIDATOR=library 时总是使用校验库
+    void validate_config(const json& config, const json& schema);
+
+    // 同上，但 $ref 不经过 schema 注册表，而是相对 schema_dir 直接读取文件（同时校验多个应用时使用）
+    void validate_config(const json& config, const json& schema, const std::string& schema_dir);
+
+    // schema 变化后只校验 config 中受影响的子树：paths 为 JSON Pointer，段为 * 时匹配任意成员或元素。
+    // 返回错误而不抛出；affected 返回 config 中是否存在这样的子树。
+    // schema 含编译程序不支持的关键字时退回完整校验，错误报告作为一条返回
+    std::vector<validation_error> validate_paths(const json& config, const json& schema, const std::string& schema_dir,
+                                                 const std::vector<std::string>& paths, bool* affected = nullptr);
+
+    // 清空编译好的校验程序（schema 文件变化后调用）
+    void clear_validation_cache();
 
 }
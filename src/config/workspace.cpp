@@ -0,0 +1,99 @@
+#include "workspace.hpp"
+#include "document.hpp"
+#include "config_file.hpp"
+#include "schema_loader.hpp"
+#include "validator.hpp"
+#include "../utils/fs.hpp"
+#include "../utils/task_pool.hpp"
+#include "../utils/trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+
+namespace config {
+
+    namespace fs = std::filesystem;
+
+    std::vector<std::string> discover_apps(const std::string& home) {
+        std::vector<std::string> apps;
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(home, ec)) {
+            std::error_code entry_ec;
+            if (!entry.is_directory(entry_ec)) continue;
+            if (fs::is_regular_file(entry.path() / "schema.json", entry_ec) &&
+                fs::is_directory(entry.path() / "configs", entry_ec)) {
+                apps.push_back(entry.path().filename().string());
+            }
+        }
+        std::sort(apps.begin(), apps.end());
+        return apps;
+    }
+
+    app_status scan_app(const std::string& home, const std::string& name) {
+        TRACE_SCOPE("scan_app", "config", name);
+        auto start = std::chrono::steady_clock::now();
+
+        app_status result;
+        result.name = name;
+        result.dir = (fs::path(home) / name).string();
+        fs::path configs_dir = fs::path(result.dir) / "configs";
+
+        try {
+            result.config_count = utils::filesystem::list_json_files(configs_dir.string()).size();
+
+            std::string target = utils::filesystem::read_symlink((configs_dir / "active").string());
+            if (target.empty()) {
+                result.status = app_status::state::no_active;
+            } else {
+                fs::path active_path(target);
+                if (active_path.is_relative()) active_path = configs_dir / active_path;
+                result.active = active_path.filename().string();
+
+                json schema = read_schema((fs::path(result.dir) / "schema.json").string());
+                // 配置在独立内存区中解析，校验完整体释放
+                document doc = load_config_document(active_path.string());
+                try {
+                    validate_config(doc.root(), schema, result.dir);
+                    result.status = app_status::state::valid;
+                } catch (const std::runtime_error& e) {
+                    result.status = app_status::state::invalid;
+                    result.message = e.what();
+                }
+            }
+        } catch (const std::exception& e) {
+            result.status = app_status::state::error;
+            result.message = e.what();
+        }
+
+        result.scan_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    std::vector<app_status> scan_workspace(const std::string& home, unsigned threads) {
+        TRACE_SCOPE("scan_workspace", "config", home);
+        auto apps = discover_apps(home);
+        std::vector<app_status> results(apps.size());
+        if (apps.empty()) return results;
+
+        // 每个应用一个任务，结果写回预先分配好的对应位置，顺序与 apps 一致；
+        // 在共享线程池上执行，应用内部的并行校验随之在同一线程上直接完成，线程数不会相乘
+        std::vector<std::function<void()>> tasks;
+        for (size_t i = 0; i < apps.size(); ++i) {
+            tasks.push_back([&, i] { results[i] = scan_app(home, apps[i]); });
+        }
+        utils::run_tasks(tasks, threads);
+        return results;
+    }
+
+    const char* to_string(app_status::state status) {
+        switch (status) {
+            case app_status::state::valid: return "valid";
+            case app_status::state::invalid: return "invalid";
+            case app_status::state::no_active: return "no-active";
+            case app_status::state::error: return "error";
+        }
+        return "unknown";
+    }
+
+}  // namespace config
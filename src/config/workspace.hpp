@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace config {
+
+    // 单个应用的扫描结果
+    struct app_status {
+        enum class state {
+            valid,      // 激活配置通过校验
+            invalid,    // 激活配置未通过校验
+            no_active,  // 没有激活配置
+            error,      // schema 或激活配置无法读取 / 解析
+        };
+
+        std::string name;        // 应用名（配置根目录下的子目录名）
+        std::string dir;         // 应用目录，含 schema.json 与 configs/
+        size_t config_count = 0; // configs/ 下的配置文件数
+        std::string active;      // 激活配置的文件名，未激活为空
+        state status = state::no_active;
+        std::string message;     // 校验或读取错误
+        double scan_ms = 0;      // 该应用的扫描耗时
+    };
+
+    // 列出配置根目录下所有受管理的应用（同时含 schema.json 与 configs/ 的子目录），按名称排序
+    std::vector<std::string> discover_apps(const std::string& home);
+
+    // 扫描单个应用：统计配置文件、读取激活配置并按该应用的 schema 校验。
+    // 不使用全局的默认配置目录和 schema 注册表，可在多个线程中同时调用
+    app_status scan_app(const std::string& home, const std::string& name);
+
+    // 并行扫描配置根目录下的所有应用，结果按应用名排序；threads 为 0 时按硬件线程数
+    std::vector<app_status> scan_workspace(const std::string& home, unsigned threads = 0);
+
+    const char* to_string(app_status::state status);
+
+}  // namespace config
@@ -1,17 +1,161 @@
+#include <fstream>
 #include <iostream>
 #include "config.h"
+#include "utils/fs.hpp"
 #include "ui/init.hpp"
 #include "ui/main_ui.hpp"
+#include "ui/workspace_view.hpp"
 
 namespace fs = std::filesystem;
 
 int main(int argc, char* argv[]) {
     try {
 
+        // 命令行查询：ConfigManager --query <应用名> <表达式>
+        if (argc > 1 && std::string(argv[1]) == "--query") {
+            if (argc < 4) {
+                std::cerr << "用法: " << argv[0] << " --query <应用名> <表达式>" << std::endl;
+                return EXIT_FAILURE;
+            }
+            config::config_index index(config::detect_default_config_dir(argv[2]));
+            index.update();
+            for (const auto& hit : index.query(argv[3])) {
+                std::cout << hit.file << "\t" << hit.pointer << "\t" << hit.value.dump() << "\n";
+            }
+            return EXIT_SUCCESS;
+        }
+
+        // 命令行工作区扫描：ConfigManager --scan，每个应用输出一行 应用名、配置数、激活配置、状态
+        if (argc > 1 && std::string(argv[1]) == "--scan") {
+            bool all_valid = true;
+            for (const auto& app : config::scan_workspace(config::config_home())) {
+                std::string message = app.message.substr(0, app.message.find('\n'));
+                std::cout << app.name << "\t" << app.config_count << "\t" << (app.active.empty() ? "-" : app.active)
+                          << "\t" << config::to_string(app.status) << "\t" << message << "\n";
+                if (app.status == config::app_status::state::invalid ||
+                    app.status == config::app_status::state::error) {
+                    all_valid = false;
+                }
+            }
+            return all_valid ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        // 命令行批量激活：ConfigManager --activate <应用名>=<配置文件> ...
+        // 全部通过各自 schema 校验后一次性切换
+        if (argc > 1 && std::string(argv[1]) == "--activate") {
+            if (argc < 3) {
+                std::cerr << "用法: " << argv[0] << " --activate <应用名>=<配置文件> ..." << std::endl;
+                return EXIT_FAILURE;
+            }
+            std::vector<config::activation> items;
+            for (int i = 2; i < argc; ++i) {
+                std::string arg = argv[i];
+                size_t eq = arg.find('=');
+                if (eq == std::string::npos || eq == 0 || eq + 1 == arg.size()) {
+                    std::cerr << "无效的参数: " << arg << std::endl;
+                    return EXIT_FAILURE;
+                }
+                std::string dir = config::detect_default_config_dir(arg.substr(0, eq));
+                std::string path = (fs::path(dir) / arg.substr(eq + 1)).string();
+                std::string app_dir = fs::path(dir).parent_path().string();
+                auto app_schema = config::read_schema((fs::path(app_dir) / "schema.json").string());
+                config::validate_config(config::load_merged_config(path), app_schema, app_dir);
+                items.push_back({dir, path});
+            }
+            config::set_active_configs(items);
+            return EXIT_SUCCESS;
+        }
+
+        // 命令行迁移：ConfigManager --migrate <应用名> <新 schema> [--from <旧 schema>] [--dry-run] [--force]
+        // 按新旧 schema 的差异迁移所有配置，--dry-run 只输出报告；否则全部配置校验通过（或 --force）时
+        // 写回配置并安装新 schema，有任何失败时不写任何文件
+        if (argc > 1 && std::string(argv[1]) == "--migrate") {
+            if (argc < 4) {
+                std::cerr << "用法: " << argv[0]
+                          << " --migrate <应用名> <新 schema> [--from <旧 schema>] [--dry-run] [--force]" << std::endl;
+                return EXIT_FAILURE;
+            }
+            std::string dir = config::detect_default_config_dir(argv[2]);
+            std::string app_dir = fs::path(dir).parent_path().string();
+            std::string installed = (fs::path(app_dir) / "schema.json").string();
+            std::string new_path = argv[3];
+            std::string old_path = installed;
+            bool dry_run = false;
+            bool force = false;
+            for (int i = 4; i < argc; ++i) {
+                std::string arg = argv[i];
+                if (arg == "--dry-run") {
+                    dry_run = true;
+                } else if (arg == "--force") {
+                    force = true;
+                } else if (arg == "--from" && i + 1 < argc) {
+                    old_path = argv[++i];
+                } else {
+                    std::cerr << "无效的参数: " << arg << std::endl;
+                    return EXIT_FAILURE;
+                }
+            }
+            std::error_code ec;
+            if (old_path == installed && fs::equivalent(new_path, installed, ec)) {
+                std::cerr << "新 schema 已经安装，请用 --from 指定旧 schema" << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            auto old_schema = config::read_schema(old_path);
+            auto new_schema = config::read_schema(new_path);
+            // 新 schema 尚未安装，默认值生成和校验中的 $ref 都相对新 schema 所在目录解析
+            std::string new_dir = fs::path(new_path).parent_path().string();
+            config::install_schema(new_path, new_schema);
+            auto results = config::migrate_configs(dir, old_schema, new_schema, new_dir.empty() ? "." : new_dir,
+                                                   dry_run, force);
+
+            bool ok = true;
+            bool any_written = false;
+            for (const auto& r : results) {
+                any_written = any_written || r.written;
+                std::string status = !r.error.empty() ? "error"
+                                     : !r.validated ? "unchecked"
+                                     : r.validation.empty() ? "valid" : "invalid";
+                std::cout << r.file << "\t" << r.changes.size() << "\t" << status
+                          << (r.written ? "\twritten" : "") << "\n";
+                for (const auto& change : r.changes) std::cout << "    " << change << "\n";
+                for (const auto& note : r.unresolved) std::cout << "    ! " << note << "\n";
+                if (!r.error.empty()) std::cout << "    " << r.error << "\n";
+                if (!r.validation.empty()) {
+                    // 校验报告第一行是标题，只显示第一条错误
+                    std::string first = r.validation.substr(r.validation.find('\n') + 1);
+                    std::cout << "    " << first.substr(0, first.find('\n')) << "\n";
+                }
+                if (status == "error" || status == "invalid") ok = false;
+            }
+
+            if (!dry_run && !ok && !force) {
+                if (any_written) {
+                    std::cerr << "部分配置写回失败，未安装新 schema" << std::endl;
+                } else {
+                    std::cerr << "存在迁移或校验失败的配置，未写入任何文件，也未安装新 schema；确认后可加 --force 强制写入"
+                              << std::endl;
+                }
+            } else if (!dry_run) {
+                std::ifstream ifs(new_path, std::ios::binary);
+                std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+                if (!fs::equivalent(new_path, installed, ec)) {
+                    utils::filesystem::write_file_atomic(installed, content);
+                    utils::filesystem::sync_dir(app_dir);
+                }
+            }
+            return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
         std::string app_name;
 
-        // 1. 获取应用名
-        if (argc > 1) {
+        // 1. 获取应用名（--workspace 时从工作区总览中选择）
+        if (argc > 1 && std::string(argv[1]) == "--workspace") {
+            app_name = ui::run_workspace_ui();
+            if (app_name.empty()) {
+                return EXIT_SUCCESS;
+            }
+        } else if (argc > 1) {
             app_name = argv[1];
         } else {
             app_name = ui::ask_app_name();
@@ -44,7 +188,8 @@ int main(int argc, char* argv[]) {
             } catch (const std::exception& e) {
                 config::remove_active_config_link();
                 ui::show_warning("激活配置校验失败",
-                    "已激活的配置文件无法通过 schema 校验，已取消激活。\n" + std::string(e.what()));
+                    "已激活的配置文件无法通过 schema 校验，已取消激活。\n"
+                    "schema 更新后可用 --migrate 迁移已有配置。\n" + std::string(e.what()));
             }
         }
 
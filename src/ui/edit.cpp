@@ -1,15 +1,26 @@
 #include "edit.hpp"
 #include "ui_utils.hpp"
 #include "../utils/fs.hpp"
+#include "../utils/trace.hpp"
 #include "../config.h"
 #include "main_ui.hpp"
+#include "navigator.hpp"
+#include "frame_stats.hpp"
+#include "search_index.hpp"
+#include "node_table.hpp"
+#include "text_editor.hpp"
+#include "enum_picker.hpp"
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/screen_interactive.hpp>
 #include <ftxui/dom/elements.hpp>
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <filesystem>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <string>
-#include <sstream>
+#include <unordered_map>
 
 using namespace ftxui;
 using json = config::json;
@@ -17,580 +28,871 @@ namespace fs = std::filesystem;
 
 namespace ui {
 
-  // 新增：分割 json_pointer 路径字符串的辅助函数
-  static std::vector<std::string> split_path(const std::string& pointer) {
-    std::vector<std::string> result;
-    std::stringstream ss(pointer);
-    std::string segment;
-    while (std::getline(ss, segment, '/')) {
-      if (!segment.empty()) {
-        // JSON Pointer 解码： ~0 -> ~ , ~1 -> /
-        std::string unescaped;
-        for (size_t i = 0; i < segment.size(); ++i) {
-          if (segment[i] == '~' && i + 1 < segment.size()) {
-            if (segment[i + 1] == '0') unescaped += '~';
-            else if (segment[i + 1] == '1') unescaped += '/';
-            ++i;
-          } else {
-            unescaped += segment[i];
-          }
-        }
-        result.push_back(unescaped);
-      }
-    }
-    return result;
-  }
-
-  struct JsonPathEntry {
-    std::vector<json::json_pointer> paths;
-    std::vector<std::string> labels;
-    std::vector<std::string> values; // 新增：存储每个路径的当前值
-  };
-
-  JsonPathEntry build_label_path_tree(const json& config, const json& schema, const std::string& base = "", json::json_pointer ptr = json::json_pointer("")) {
-    JsonPathEntry result;
-
-    if (!schema.contains("type")) return result;
-    std::string type = schema["type"];
-
-    if (type == "object" && schema.contains("properties")) {
-      for (auto& [key, prop_schema] : schema["properties"].items()) {
-        auto child_ptr = ptr / key;
-        std::string label = base + key;
-
-        // 获取当前值（如果是基本类型）
-        std::string value_str = "";
-        if (config.contains(child_ptr)) {
-          const json& val = config[child_ptr];
-          if (prop_schema.contains("type")) {
-            std::string prop_type = prop_schema["type"];
-            if (prop_type != "object" && prop_type != "array") {
-              if (prop_type == "boolean") {
-                value_str = val.get<bool>() ? "true" : "false";
-              } else if (prop_type == "string") {
-                value_str = "\"" + val.get<std::string>() + "\"";
-              } else {
-                value_str = val.dump();
-              }
-            }
-          } else {
-            value_str = val.dump();
-          }
-        }
+  namespace {
 
-        // 如果值太长，截断
-        if (value_str.length() > 15) {
-          value_str = value_str.substr(0, 12) + "...";
-        }
+    // 超过该长度或含换行的字符串使用多行编辑器
+    constexpr size_t long_text_threshold = 256;
 
-        result.labels.push_back(label);
-        result.paths.push_back(child_ptr);
-        result.values.push_back(value_str); // 存储值
+    bool is_long_text(const json& value) {
+      if (!value.is_string()) return false;
+      const auto& s = value.get_ref<const std::string&>();
+      return s.size() > long_text_threshold || s.find('\n') != std::string::npos;
+    }
 
-        auto child = build_label_path_tree(config, prop_schema, base + "  ", child_ptr);
-        result.labels.insert(result.labels.end(), child.labels.begin(), child.labels.end());
-        result.paths.insert(result.paths.end(), child.paths.begin(), child.paths.end());
-        result.values.insert(result.values.end(), child.values.begin(), child.values.end());
-      }
-    } else if (type == "array" && schema.contains("items")) {
-      const json& arr = config.contains(ptr) ? config[ptr] : json::array();
-      for (int i = 0; i < arr.size(); ++i) {
-        auto item_ptr = ptr / std::to_string(i);
-        std::string label = base + "[" + std::to_string(i) + "]";
-
-        // 数组元素不显示值（只显示索引）
-        result.labels.push_back(label);
-        result.paths.push_back(item_ptr);
-        result.values.push_back(""); // 空值
-
-        auto child = build_label_path_tree(config, schema["items"], base + "  ", item_ptr);
-        result.labels.insert(result.labels.end(), child.labels.begin(), child.labels.end());
-        result.paths.insert(result.paths.end(), child.paths.begin(), child.paths.end());
-        result.values.insert(result.values.end(), child.values.begin(), child.values.end());
-      }
+    // 当前值的显示文本：长字符串只显示开头一段和总长度，不序列化整个值
+    std::string preview_value(const json* value) {
+      if (!value) return "null";
+      if (!is_long_text(*value)) return value->dump();
+      const auto& s = value->get_ref<const std::string&>();
+      size_t cut = std::min({s.find('\n'), s.size(), static_cast<size_t>(40)});
+      while (cut > 0 && cut < s.size() && (static_cast<unsigned char>(s[cut]) & 0xC0) == 0x80) --cut;
+      return "\"" + s.substr(0, cut) + "...\" (" + std::to_string(s.size()) + " 字节)";
     }
 
-    return result;
-  }
+    // 编辑界面：左侧为配置项树，右侧为选中项的详情与编辑器
+    // 视图状态都是成员，随组件一起由 navigator 释放
+    class edit_view : public ComponentBase {
+    public:
+      edit_view(navigator& owner, const std::string& config_path)
+          : nav(owner), schema(owner.schema()), path(config_path),
+            doc(config::load_config_document(config_path)), config(doc.root()), hashes(config), current_schema_ptr(&owner.schema()) {
+        // 子树哈希：判断是否有未保存的修改，以及当前内容是否已经校验过
+        hashes.mark_clean();
+
+        update_menu_tree();
+        for (int row = 0; row < static_cast<int>(nodes.size()); row++) index.insert(nodes.pointer(row));
+        if (!nodes.empty()) select_path_by_index();
+
+        // 初始化菜单项
+        update_menu_items();
+
+        // schema 文件被修改后由 navigator 在界面线程通知
+        nav.on_schema_reload = [this](const config::schema_reload& reload) { on_schema_reload(reload); };
+
+        // 更新按钮
+        update_button = Button("更新", [this] { on_update(); });
+
+        // 添加数组项按钮
+        add_button = Button("添加新项", [this] { on_add_item(); });
+
+        // 删除数组项按钮
+        delete_button = Button("删除此项", [this] { on_delete_item(); });
+
+        // 数组批量操作：范围删除、插入多项默认值、移动、粘贴或从文件导入
+        bulk_range_input = Input(&bulk_range, "下标范围，如 0-9,15");
+        bulk_count_input = Input(&bulk_count, "数量");
+        bulk_target_input = Input(&bulk_target, "目标位置，留空为末尾");
+        bulk_import_input = Input(&bulk_import, "JSON 数组、NDJSON 或文件路径");
+        bulk_buttons = Container::Horizontal({
+          Button("插入N项", [this] { on_insert_items(); }),
+          Button("删除范围", [this] { on_erase_range(); }),
+          Button("移动范围", [this] { on_move_range(); }),
+          Button("导入", [this] { on_import_items(); })
+        });
+        auto bulk_inputs = Container::Vertical({
+          bulk_range_input, bulk_count_input, bulk_target_input, bulk_import_input, bulk_buttons
+        });
+        bulk_panel = Renderer(bulk_inputs, [this] {
+          return vbox({
+            text("批量操作") | bold,
+            hbox({text("范围: "), bulk_range_input->Render()}),
+            hbox({text("数量: "), bulk_count_input->Render()}),
+            hbox({text("位置: "), bulk_target_input->Render()}),
+            hbox({text("导入: "), bulk_import_input->Render()}),
+            bulk_buttons->Render()
+          });
+        });
+
+        MenuOption option;
+        option.on_change = [this] {
+          if (menu_selected >= 0 && menu_selected < static_cast<int>(visible_rows.size())) {
+            selected = visible_rows[menu_selected];
+            select_path_by_index();
+          }
+        };
+
+        // 使用标准Menu组件，显示经过搜索过滤的行
+        menu = Menu(&visible_items, &menu_selected, option);
+
+        // 搜索框：输入关键字过滤配置项，以 / 开头时按 JSON Pointer 跳转
+        InputOption search_option;
+        search_option.on_change = [this] { on_search_change(); };
+        search_input = Input(&search_query, "搜索，或输入 /路径 跳转", search_option);
+
+        // 右侧面板组件
+        description_display = Renderer([this] {
+          int max_width = std::max(20, right_panel_width);
+          if (description_dirty) {
+            description_lines = ui::make_wrapped_text(description, max_width);
+            description_dirty = false;
+          }
 
-  void edit_config(const std::string& path, const std::string& app_name, const config::json& schema) {
-    json config = config::load_config(path);
+          return vbox({
+            text("描述:") | bold,
+            vbox(description_lines)
+              | size(WIDTH, EQUAL, max_width)   // 确保宽度和 wrap 时一致
+              | size(HEIGHT, EQUAL, 7)
+              | frame
+              | vscroll_indicator
+          });
+        });
+
+        current_value_display = Renderer([this] {
+          std::string current_value;
+          if (selected >= 0 && selected < static_cast<int>(nodes.size())) {
+            if (current_schema_ptr->contains("type") && (*current_schema_ptr)["type"] == "boolean") {
+              current_value = bool_value ? "true" : "false";
+            } else if (current_schema_ptr->contains("enum") && enum_state.selected >= 0) {
+              current_value = enum_state.index->label(enum_state.selected);
+            } else {
+              if (value_text_dirty) {
+                value_text = preview_value(nodes[selected].value);
+                value_text_dirty = false;
+              }
+              current_value = value_text;
+            }
+          }
+          if (editing_long_text && long_text_modified) {
+            return hbox({text("当前值: "), text(current_value), text(" [已修改，点击更新写入]") | color(Color::Yellow)});
+          }
+          return hbox({text("当前值: "), text(current_value)});
+        });
 
-    std::string status_message;
-    std::string description;
-    std::string edit_buffer;
-    int enum_selected = 0;
-    bool bool_value = false;
+        separator_renderer = Renderer([] { return separator(); });
 
-    // 持久的枚举选项向量
-    std::vector<std::string> enum_options;
+        // 动态编辑器组件
+        editor_component = Input(&edit_buffer, "编辑值");
 
-    auto screen = ScreenInteractive::Fullscreen();
+        // 长字符串（证书、脚本、模板等）的多行编辑器，只渲染可见行
+        long_text_editor = make_text_editor(&long_text, 12, right_panel_width, [this] { long_text_modified = true; });
 
-    std::vector<std::string> menu_labels;
-    std::vector<json::json_pointer> menu_paths;
-    std::vector<std::string> menu_values;
-    int selected = 0;
+        // 枚举选项可能有上千个，只渲染可见的部分
+        enum_picker = make_enum_picker(&enum_state, 10, right_panel_width);
 
-    auto update_menu_tree = [&] {
-      auto entry = build_label_path_tree(config, schema);
-      menu_labels = std::move(entry.labels);
-      menu_paths = std::move(entry.paths);
-      menu_values = std::move(entry.values);
-    };
+        // 右侧面板容器
+        right_panel = Container::Vertical({});
+        array_buttons = Container::Horizontal({});
 
-    // 存储当前选中的schema信息
-    const json* current_schema_ptr = &schema;
-    json::json_pointer current_parent_ptr;
-    bool current_is_array = false;
-    bool current_is_array_element = false;
-    int current_min_items = 0;
+        // 初始化右侧面板
+        update_right_panel();
 
-    auto select_path_by_index = [&] {
-      if (selected >= 0 && selected < menu_paths.size()) {
-        json::json_pointer ptr = menu_paths[selected];
-        const json& val = config[ptr];
+        auto layout = Container::Horizontal({
+          // 左侧面板（搜索框 + 菜单）
+          Container::Vertical({search_input, menu}) | size(WIDTH, EQUAL, left_panel_width),
+          // 右侧面板
+          right_panel | size(WIDTH, EQUAL, right_panel_width)
+        });
+
+        buttons = Container::Horizontal({
+          Button("保存配置", [this] { on_save(); }),
+          Button("激活配置", [this] { on_activate(); }),
+          Button("删除配置", [this] { on_delete(); }),
+          Button("返回", [this] { nav.show_main(); })
+        });
+
+        // 修复：使用正确的容器结构
+        auto main_container = Container::Vertical({
+          layout,
+          buttons
+        });
+
+        Add(Renderer(main_container, [this] { return render(); }));
+      }
 
-        // 重置状态
-        current_is_array = false;
-        current_is_array_element = false;
-        current_min_items = 0;
+    private:
+      void update_menu_tree() {
+        TRACE_SCOPE("build_node_table", "ui");
+        nodes.build(config, schema);
+      }
 
-        // 获取当前指针的schema
+      // schema 替换后节点表中的子 schema 地址全部失效：按路径保留选中项，重建节点表、菜单和索引，
+      // 再只校验当前配置中受变化影响的子树
+      void on_schema_reload(const config::schema_reload& reload) {
+        if (!reload.error.empty()) {
+          status_message = nav.schema_status();
+          return;
+        }
+        std::string current = selected >= 0 && selected < static_cast<int>(nodes.size()) ? nodes.pointer(selected) : "";
+        enum_state.reset(nullptr, -1);
+        enum_indexes.clear();
         current_schema_ptr = &schema;
-        auto tokens = split_path(ptr.to_string());
-        for (const std::string& key : tokens) {
-          if (current_schema_ptr->contains("type") && (*current_schema_ptr)["type"] == "array") {
-            if (current_schema_ptr->contains("items"))
-              current_schema_ptr = &(*current_schema_ptr)["items"];
-          } else if (current_schema_ptr->contains("properties") && (*current_schema_ptr)["properties"].contains(key)) {
-            current_schema_ptr = &(*current_schema_ptr)["properties"][key];
+
+        update_menu_tree();
+        index.clear();
+        for (int row = 0; row < static_cast<int>(nodes.size()); row++) index.insert(nodes.pointer(row));
+        int row = nodes.find(current);
+        selected = row >= 0 ? row : 0;
+        if (!nodes.empty()) select_path_by_index();
+        update_menu_items();
+        right_panel_dirty = true;
+        description_dirty = true;
+        value_text_dirty = true;
+        validated = false;
+
+        if (reload.changed.empty()) {
+          status_message = nav.schema_status();
+          return;
+        }
+        try {
+          bool affected = false;
+          // 分层配置校验合并后的结果（与激活时一致）
+          json merged;
+          const json* target = &config;
+          if (config::is_layered(config)) {
+            merged = config::load_merged_config(path);
+            target = &merged;
+          }
+          auto errors = config::validate_paths(*target, schema, config::current_schema_registry()->dir(), reload.changed, &affected);
+          if (!affected) {
+            status_message = "schema 已更新，当前配置不受影响";
+          } else if (errors.empty()) {
+            status_message = "schema 已更新，当前配置受影响的部分校验通过";
+          } else {
+            const auto& first = errors.front();
+            status_message = "schema 已更新，当前配置有 " + std::to_string(errors.size()) + " 处不符合: " +
+                             (first.pointer.empty() ? "" : first.pointer + " ") + first.message;
           }
+        } catch (const std::exception& e) {
+          status_message = std::string("schema 已更新，校验失败: ") + e.what();
         }
+      }
 
-        // 检查是否是数组元素
-        if (!ptr.empty()) {
-          current_parent_ptr = ptr.parent_pointer();
-          if (config.contains(current_parent_ptr) && config[current_parent_ptr].is_array()) {
-            current_is_array_element = true;
-
-            // 获取父数组的schema
-            const json* parent_schema_ptr = &schema;
-            auto parent_tokens = split_path(current_parent_ptr.to_string());
-            for (const std::string& key : parent_tokens) {
-              if (parent_schema_ptr->contains("type") && (*parent_schema_ptr)["type"] == "array") {
-                if (parent_schema_ptr->contains("items"))
-                  parent_schema_ptr = &(*parent_schema_ptr)["items"];
-              } else if (parent_schema_ptr->contains("properties") && (*parent_schema_ptr)["properties"].contains(key)) {
-                parent_schema_ptr = &(*parent_schema_ptr)["properties"][key];
-              }
-            }
+      const enum_index& enum_index_of(const json& subschema) {
+        auto& cached = enum_indexes[&subschema];
+        if (!cached) cached = std::make_unique<enum_index>(subschema["enum"]);
+        return *cached;
+      }
 
-            // 获取minItems约束
-            if (parent_schema_ptr->contains("minItems")) {
-              current_min_items = (*parent_schema_ptr)["minItems"].get<int>();
-            }
-          }
+      // row 的子树结构变化后（如增删数组元素），只重建这部分节点、菜单项和索引条目
+      void refresh_subtree(int row) {
+        TRACE_SCOPE("refresh_subtree", "ui");
+        int old_end = nodes[row].end;
+        nodes.rebuild_children(row);
+        std::vector<std::string> labels;
+        labels.reserve(nodes[row].end - row - 1);
+        for (int r = row + 1; r < nodes[row].end; r++) labels.push_back(nodes.label(r));
+        menu_items.erase(menu_items.begin() + row + 1, menu_items.begin() + old_end);
+        menu_items.insert(menu_items.begin() + row + 1,
+                          std::make_move_iterator(labels.begin()), std::make_move_iterator(labels.end()));
+        menu_items[row] = nodes.label(row);
+        reindex_children(row);
+        apply_filter();
+      }
+
+      // 结构变化后只更新 row 子树的索引条目（子树在菜单中是连续的行）
+      void reindex_children(int row) {
+        index.erase_children(nodes.pointer(row));
+        for (int i = row + 1; i < nodes[row].end; i++) {
+          index.insert(nodes.pointer(i));
         }
+      }
 
-        // 检查当前项是否是数组
-        if (current_schema_ptr->contains("type") && (*current_schema_ptr)["type"] == "array") {
-          current_is_array = true;
-          if (current_schema_ptr->contains("minItems")) {
-            current_min_items = (*current_schema_ptr)["minItems"].get<int>();
+      bool filtering() const {
+        return !search_query.empty() && search_query[0] != '/';
+      }
+
+      // 根据搜索词重新计算可见行
+      void apply_filter() {
+        visible_rows.clear();
+        visible_items.clear();
+        if (!filtering()) {
+          for (int i = 0; i < static_cast<int>(menu_items.size()); i++) visible_rows.push_back(i);
+          visible_items = menu_items;
+        } else {
+          for (const auto& key : index.search(search_query)) {
+            int row = nodes.find(key);
+            if (row >= 0) visible_rows.push_back(row);
           }
+          std::sort(visible_rows.begin(), visible_rows.end());
+          for (int row : visible_rows) visible_items.push_back(menu_items[row]);
         }
+        sync_menu_selection();
+      }
 
-        if (current_schema_ptr->contains("description"))
-          description = (*current_schema_ptr)["description"].get<std::string>();
-        else
-          description = "无描述";
-
-        if (current_schema_ptr->contains("type") && (*current_schema_ptr)["type"] == "boolean") {
-          bool_value = val.get<bool>();
-          edit_buffer = "";
+      // 让菜单的光标对准 selected 所在行（不可见时取最近的可见行）
+      void sync_menu_selection() {
+        auto it = std::lower_bound(visible_rows.begin(), visible_rows.end(), selected);
+        if (it == visible_rows.end()) {
+          menu_selected = std::max(0, static_cast<int>(visible_rows.size()) - 1);
+        } else {
+          menu_selected = static_cast<int>(it - visible_rows.begin());
         }
-        else if (current_schema_ptr->contains("enum")) {
-          const auto& enum_vals = (*current_schema_ptr)["enum"];
-          std::string current_val = val.get<std::string>();
-
-          // 更新枚举选项
-          enum_options.clear();
-          for (const auto& option : enum_vals) {
-            enum_options.push_back(option.get<std::string>());
-          }
+      }
 
-          // 设置当前选中项
-          for (int i = 0; i < enum_options.size(); i++) {
-            if (enum_options[i] == current_val) {
-              enum_selected = i;
-              break;
-            }
+      void on_search_change() {
+        if (!search_query.empty() && search_query[0] == '/') {
+          int row = index.contains(search_query) ? nodes.find(search_query) : -1;
+          if (row >= 0) {
+            selected = row;
+            select_path_by_index();
+            status_message = "已跳转到 " + search_query;
           }
-          edit_buffer = "";
+          apply_filter();
+          return;
         }
-        else if (current_schema_ptr->contains("type")) {
-          std::string type = (*current_schema_ptr)["type"];
-          if (type == "string") {
-            edit_buffer = val.get<std::string>();
-          } else {
-            edit_buffer = val.dump();
-          }
-        } else {
-          edit_buffer = val.dump();
+        apply_filter();
+        if (!visible_rows.empty() && visible_rows[menu_selected] != selected) {
+          selected = visible_rows[menu_selected];
+          select_path_by_index();
         }
       }
-    };
 
-    update_menu_tree();
-    if (!menu_paths.empty()) select_path_by_index();
+      // 创建带值的菜单项
+      // 值变化但行结构不变时只更新这一行的菜单文本；搜索索引只含路径，可见行不受影响
+      void update_label(int row) {
+        menu_items[row] = nodes.label(row);
+        auto it = std::lower_bound(visible_rows.begin(), visible_rows.end(), row);
+        if (it != visible_rows.end() && *it == row) visible_items[it - visible_rows.begin()] = menu_items[row];
+      }
 
-    // 创建带值的菜单项
-    std::vector<std::string> menu_items;
-    auto update_menu_items = [&] {
-      menu_items.clear();
-      for (size_t i = 0; i < menu_labels.size(); i++) {
-        if (!menu_values[i].empty()) {
-          menu_items.push_back(menu_labels[i] + ": " + menu_values[i]);
-        } else {
-          menu_items.push_back(menu_labels[i]);
+      void update_menu_items() {
+        menu_items.clear();
+        menu_items.reserve(nodes.size());
+        for (int row = 0; row < static_cast<int>(nodes.size()); row++) {
+          menu_items.push_back(nodes.label(row));
         }
+        apply_filter();
       }
-    };
 
-    // 初始化菜单项
-    update_menu_items();
+      void select_path_by_index() {
+        if (selected >= 0 && selected < static_cast<int>(nodes.size())) {
+          // 配置中尚不存在的键：先补上 null（数组、对象的存储可能因此移动，需重建节点表）
+          if (!nodes[selected].value) {
+            json::json_pointer ptr(nodes.pointer(selected));
+            config[ptr] = nullptr;
+            hashes.invalidate(ptr);
+            update_menu_tree();
+          }
+          const auto& node = nodes[selected];
+          const json& val = *node.value;
+
+          right_panel_dirty = true;
+          description_dirty = true;
+          value_text_dirty = true;
+          sync_menu_selection();
+
+          // 重置状态
+          editing_long_text = false;
+          current_is_array = false;
+          current_is_array_element = node.array_element;
+          current_min_items = 0;
+
+          // 当前节点的schema
+          current_schema_ptr = node.schema;
+
+          // 数组元素：获取父数组的minItems约束
+          if (current_is_array_element) {
+            const json& parent_schema = nodes.parent_schema(selected);
+            if (parent_schema.contains("minItems")) {
+              current_min_items = parent_schema["minItems"].get<int>();
+            }
+          }
 
-    // 更新按钮
-    auto update_button = Button("更新", [&] {
-      if (selected >= 0 && selected < menu_paths.size()) {
-        try {
-          json::json_pointer ptr = menu_paths[selected];
-          json parsed;
+          // 检查当前项是否是数组
+          if (current_schema_ptr->contains("type") && (*current_schema_ptr)["type"] == "array") {
+            current_is_array = true;
+            if (current_schema_ptr->contains("minItems")) {
+              current_min_items = (*current_schema_ptr)["minItems"].get<int>();
+            }
+          }
+
+          if (current_schema_ptr->contains("description"))
+            description = (*current_schema_ptr)["description"].get<std::string>();
+          else
+            description = "无描述";
 
           if (current_schema_ptr->contains("type") && (*current_schema_ptr)["type"] == "boolean") {
-            parsed = bool_value;
+            bool_value = val.get<bool>();
+            edit_buffer = "";
           }
           else if (current_schema_ptr->contains("enum")) {
-            parsed = enum_options[enum_selected];
+            // 选项索引按子 schema 缓存，再次选中同类字段时直接复用
+            const enum_index& options = enum_index_of(*current_schema_ptr);
+            enum_state.reset(&options, options.find(val));
+            edit_buffer = "";
           }
           else if (current_schema_ptr->contains("type")) {
             std::string type = (*current_schema_ptr)["type"];
-            if (type == "string") {
-              parsed = edit_buffer;
+            if (type == "string" && is_long_text(val)) {
+              // 长字符串直接载入多行编辑缓冲，不再复制到单行输入框
+              editing_long_text = true;
+              long_text_modified = false;
+              long_text.assign(val.get_ref<const std::string&>());
+              long_text_editor->reset();
+              edit_buffer.clear();
+            } else if (type == "string") {
+              edit_buffer = val.get<std::string>();
             } else {
-              parsed = json::parse(edit_buffer);
+              edit_buffer = val.dump();
             }
           } else {
-            parsed = json::parse(edit_buffer);
+            edit_buffer = val.dump();
           }
+        }
+      }
 
-          config[ptr] = parsed;
+      void on_update() {
+        if (selected >= 0 && selected < static_cast<int>(nodes.size()) && editing_long_text) {
+          // 多行编辑器的内容直接写入配置中的字符串，复用其已有容量
+          json& value = *nodes[selected].value;
+          if (!value.is_string()) value = "";
+          long_text.write_to(value.get_ref<std::string&>());
+          long_text_modified = false;
+          hashes.invalidate(json::json_pointer(nodes.pointer(selected)));
+          value_text_dirty = true;
+          update_label(selected);
           status_message = "更新成功";
+          return;
+        }
+        if (selected >= 0 && selected < static_cast<int>(nodes.size())) {
+          try {
+            json parsed;
+
+            if (current_schema_ptr->contains("type") && (*current_schema_ptr)["type"] == "boolean") {
+              parsed = bool_value;
+            }
+            else if (current_schema_ptr->contains("enum")) {
+              if (enum_state.selected < 0) {
+                status_message = "请先选择一个选项";
+                return;
+              }
+              parsed = enum_state.index->value(enum_state.selected);
+            }
+            else if (current_schema_ptr->contains("type")) {
+              std::string type = (*current_schema_ptr)["type"];
+              if (type == "string") {
+                parsed = edit_buffer;
+              } else {
+                parsed = json::parse(edit_buffer);
+              }
+            } else {
+              parsed = json::parse(edit_buffer);
+            }
 
-          // 更新菜单树和菜单项
-          update_menu_tree();
-          update_menu_items();
-        } catch (...) {
-          status_message = "更新失败：无效 JSON 或类型不匹配";
+            // 新旧值都是基本类型时行结构不变，只更新这一行；涉及对象或数组时子项随之变化，只重建这一子树
+            json& value = *nodes[selected].value;
+            const bool structured = value.is_structured() || parsed.is_structured();
+            value = std::move(parsed);
+            hashes.invalidate(json::json_pointer(nodes.pointer(selected)));
+            value_text_dirty = true;
+            status_message = "更新成功";
+
+            if (structured) {
+              refresh_subtree(selected);
+            } else {
+              update_label(selected);
+            }
+          } catch (...) {
+            status_message = "更新失败：无效 JSON 或类型不匹配";
+          }
         }
       }
-    });
 
-    // 添加数组项按钮
-    auto add_button = Button("添加新项", [&] {
-      if (selected >= 0 && selected < menu_paths.size() && current_is_array) {
-        try {
-          json::json_pointer array_ptr = menu_paths[selected];
+      void on_add_item() {
+        if (selected >= 0 && selected < static_cast<int>(nodes.size()) && current_is_array) {
+          try {
+            int array_row = selected;
+            json& arr = *nodes[array_row].value;
 
-          // 创建新项的默认值
-          if (current_schema_ptr->contains("items")) {
-            json new_item = config::generate_default_config((*current_schema_ptr)["items"]);
-            config[array_ptr].push_back(new_item);
+            // 创建新项的默认值
+            if (current_schema_ptr->contains("items")) {
+              json new_item = config::generate_default_config((*current_schema_ptr)["items"]);
+              if (!arr.is_array()) arr = json::array();
+              arr.push_back(new_item);
+              hashes.invalidate(json::json_pointer(nodes.pointer(array_row)));
 
-            status_message = "已添加新项";
+              status_message = "已添加新项";
 
-            // 更新菜单树和菜单项
-            update_menu_tree();
-            update_menu_items();
-
-            // 选中新添加的项
-            int new_index = config[array_ptr].size() - 1;
-            json::json_pointer new_ptr = array_ptr / std::to_string(new_index);
-            for (int i = 0; i < menu_paths.size(); i++) {
-              if (menu_paths[i] == new_ptr) {
-                selected = i;
+              // 只刷新数组的子树
+              refresh_subtree(array_row);
+
+              // 选中新添加的项
+              int new_row = nodes.find(&arr.back());
+              if (new_row >= 0) {
+                selected = new_row;
                 select_path_by_index();
-                break;
               }
             }
+          } catch (...) {
+            status_message = "添加失败";
           }
-        } catch (...) {
-          status_message = "添加失败";
         }
       }
-    });
-
-    // 删除数组项按钮
-    auto delete_button = Button("删除此项", [&] {
-      if (selected >= 0 && selected < menu_paths.size() && current_is_array_element) {
-        try {
-          json::json_pointer element_ptr = menu_paths[selected];
-          json::json_pointer parent_ptr = element_ptr.parent_pointer();
-
-          // 检查minItems约束
-          int current_size = config[parent_ptr].size();
-          if (current_min_items > 0 && current_size <= current_min_items) {
-            status_message = "无法删除：数组元素数量不能小于minItems(" + std::to_string(current_min_items) + ")";
-            return;
-          }
 
-          // 确认对话框
-          if (confirm_dialog("确认删除", "是否删除该项？")) {
-            // 获取索引
-            std::string index_str = element_ptr.back();
-            int index = std::stoi(index_str);
+      void on_delete_item() {
+        if (selected >= 0 && selected < static_cast<int>(nodes.size()) && current_is_array_element) {
+          try {
+            int parent_row = nodes[selected].parent;
+            json& arr = *nodes.parent_value(selected);
+
+            // 检查minItems约束
+            int current_size = arr.size();
+            if (current_min_items > 0 && current_size <= current_min_items) {
+              status_message = "无法删除：数组元素数量不能小于minItems(" + std::to_string(current_min_items) + ")";
+              return;
+            }
 
-            // 删除元素
-            json& arr = config[parent_ptr];
-            arr.erase(arr.begin() + index);
+            // 确认对话框
+            if (nav.confirm("确认删除", "是否删除该项？")) {
+              // 删除元素
+              int index = std::stoi(nodes[selected].key);
+              arr.erase(arr.begin() + index);
+              hashes.invalidate(json::json_pointer(nodes.pointer(parent_row)));
 
-            status_message = "已删除项";
+              status_message = "已删除项";
 
-            // 更新菜单树和菜单项
-            update_menu_tree();
-            update_menu_items();
+              // 只刷新父数组的子树
+              refresh_subtree(parent_row);
 
-            // 选中父数组
-            for (int i = 0; i < menu_paths.size(); i++) {
-              if (menu_paths[i] == parent_ptr) {
-                selected = i;
-                select_path_by_index();
-                break;
-              }
+              // 选中父数组
+              selected = parent_row;
+              select_path_by_index();
             }
+          } catch (...) {
+            status_message = "删除失败";
           }
-        } catch (...) {
-          status_message = "删除失败";
         }
       }
-    });
 
-    MenuOption option;
-    option.on_change = [&] {
-      select_path_by_index();
-    };
-
-    // 使用标准Menu组件
-    auto menu = Menu(&menu_items, &selected, option);
-
-    // 固定左右面板大小
-    int left_panel_width = 50; // 左侧面板宽度
-    int right_panel_width = 60; // 右侧面板宽度
-
-    // 右侧面板组件
-    Component description_display = Renderer([&] {
-      int max_width = std::max(20, right_panel_width);
-      auto lines = ui::make_wrapped_text(description, max_width);
-
-      return vbox({
-        text("描述:") | bold,
-        vbox(lines)
-          | size(WIDTH, EQUAL, max_width)   // 确保宽度和 wrap 时一致
-          | size(HEIGHT, EQUAL, 7)
-          | frame
-          | vscroll_indicator
-      });
-    });
-
-
-    Component current_value_display = Renderer([&] {
-      std::string current_value;
-      if (selected >= 0 && selected < menu_paths.size()) {
-        json::json_pointer ptr = menu_paths[selected];
-        const json& val = config[ptr];
-
-        if (current_schema_ptr->contains("type") && (*current_schema_ptr)["type"] == "boolean") {
-          current_value = bool_value ? "true" : "false";
-        } else if (current_schema_ptr->contains("enum")) {
-          current_value = enum_options.empty() ? "" : enum_options[enum_selected];
-        } else {
-          current_value = val.dump();
+      // 对选中的数组执行一次批量修改（op 返回状态栏消息）：哈希只失效一次，子树只刷新一次
+      void apply_array_batch(const std::function<std::string(json&)>& op) {
+        if (selected < 0 || selected >= static_cast<int>(nodes.size()) || !current_is_array) return;
+        int array_row = selected;
+        try {
+          json& arr = *nodes[array_row].value;
+          if (!arr.is_array()) arr = json::array();
+          std::string done = op(arr);
+          hashes.invalidate(json::json_pointer(nodes.pointer(array_row)));
+          refresh_subtree(array_row);
+          status_message = done;
+          select_path_by_index();
+        } catch (const std::exception& e) {
+          status_message = std::string("批量操作失败: ") + e.what();
         }
       }
-      return hbox({text("当前值: "), text(current_value)});
-    });
-
-    Component separator_renderer = Renderer([] { return separator(); });
 
-    // 动态编辑器组件
-    Component editor_component = Input(&edit_buffer, "编辑值");
-
-    // 右侧面板容器
-    auto right_panel = Container::Vertical({});
-    auto array_buttons = Container::Horizontal({});
-
-    // 更新右侧面板
-    auto update_right_panel = [&] {
-      right_panel->DetachAllChildren();
-      array_buttons->DetachAllChildren();
+      // 数组最多还能增加的项数（schema 的 maxItems），无限制时为 SIZE_MAX
+      size_t remaining_capacity(const json& arr) const {
+        if (!current_schema_ptr->contains("maxItems")) return SIZE_MAX;
+        size_t max_items = (*current_schema_ptr)["maxItems"].get<size_t>();
+        size_t size = arr.is_array() ? arr.size() : 0;
+        return max_items > size ? max_items - size : 0;
+      }
 
-      // 添加固定组件
-      right_panel->Add(description_display);
-      if (!current_is_array && (!current_schema_ptr->contains("type") || (*current_schema_ptr)["type"] != "object")) {
-        right_panel->Add(current_value_display);
+      size_t bulk_position(const json& arr) const {
+        return bulk_target.empty() ? (arr.is_array() ? arr.size() : 0) : config::parse_index(bulk_target);
       }
-      right_panel->Add(separator_renderer);
 
-      // 判断当前项是否为数组或对象，只有当前项既不是数组也不是对象时才显示编辑相关组件
-      if (!current_is_array && (!current_schema_ptr->contains("type") || (*current_schema_ptr)["type"] != "object")) {
-        if (selected >= 0 && selected < menu_paths.size()) {
-          // 布尔类型 - 显示复选框
-          if (current_schema_ptr->contains("type") && (*current_schema_ptr)["type"] == "boolean") {
-            editor_component = Checkbox("启用", &bool_value);
+      void on_insert_items() {
+        apply_array_batch([this](json& arr) {
+          size_t count = bulk_count.empty() ? 1 : config::parse_index(bulk_count);
+          if (count > config::max_bulk_items) {
+            throw std::runtime_error("单次最多插入 " + std::to_string(config::max_bulk_items) + " 项");
           }
-          // 枚举类型 - 显示切换按钮
-          else if (current_schema_ptr->contains("enum")) {
-            // 使用持久的 enum_options 向量
-            editor_component = Radiobox(&enum_options, &enum_selected);
+          if (count > remaining_capacity(arr)) {
+            throw std::runtime_error("超过 maxItems 限制");
           }
-          // 其他类型 - 显示文本输入框
-          else {
-            editor_component = Input(&edit_buffer, "编辑值");
-          }
-        } else {
-          editor_component = Input(&edit_buffer, "编辑值");
-        }
-
-        // 添加编辑器和更新按钮
-        right_panel->Add(editor_component);
-        right_panel->Add(update_button);
-      }
-      // 添加数组操作按钮
-      if (current_is_array) {
-        array_buttons->Add(add_button);
+          json item = current_schema_ptr->contains("items")
+                          ? config::generate_default_config((*current_schema_ptr)["items"])
+                          : json();
+          config::insert_items(arr, bulk_position(arr), std::vector<json>(count, item));
+          return "已插入 " + std::to_string(count) + " 项";
+        });
       }
-      if (current_is_array_element) {
-        array_buttons->Add(delete_button);
+
+      void on_erase_range() {
+        if (selected < 0 || selected >= static_cast<int>(nodes.size()) || !current_is_array) return;
+        const json& arr = *nodes[selected].value;
+        std::vector<size_t> indices;
+        try {
+          indices = config::parse_index_ranges(bulk_range, arr.is_array() ? arr.size() : 0);
+        } catch (const std::exception& e) {
+          status_message = std::string("范围无效: ") + e.what();
+          return;
+        }
+        if (current_min_items > 0 && arr.size() - indices.size() < static_cast<size_t>(current_min_items)) {
+          status_message = "无法删除：数组元素数量不能小于minItems(" + std::to_string(current_min_items) + ")";
+          return;
+        }
+        // 整个范围只确认一次
+        if (!nav.confirm("确认删除", "是否删除选中的 " + std::to_string(indices.size()) + " 项？")) return;
+        apply_array_batch([&indices](json& a) {
+          config::erase_items(a, indices);
+          return "已删除 " + std::to_string(indices.size()) + " 项";
+        });
       }
 
-      if (array_buttons->ChildCount() > 0) {
-        right_panel->Add(array_buttons);
+      void on_move_range() {
+        apply_array_batch([this](json& arr) {
+          auto indices = config::parse_index_ranges(bulk_range, arr.size());
+          config::move_items(arr, indices, bulk_position(arr));
+          return "已移动 " + std::to_string(indices.size()) + " 项";
+        });
       }
-    };
 
-    // 初始化右侧面板
-    update_right_panel();
-
-    auto layout = Container::Horizontal({
-      // 左侧面板（菜单）
-      menu | size(WIDTH, EQUAL, left_panel_width),
-      // 右侧面板
-      right_panel | size(WIDTH, EQUAL, right_panel_width)
-    });
-
-    auto on_save = [&] {
-      try {
-        config::save_config(path, config);
-        status_message = "保存成功";
-      } catch (const std::exception& e) {
-        status_message = std::string("保存失败: ") + e.what();
+      void on_import_items() {
+        apply_array_batch([this](json& arr) {
+          // 已存在的文件按文件导入，否则把输入内容本身当作 JSON 数组或 NDJSON
+          std::error_code ec;
+          auto items = fs::is_regular_file(bulk_import, ec) ? config::load_items(bulk_import)
+                                                            : config::parse_items(bulk_import);
+          if (items.size() > remaining_capacity(arr)) {
+            throw std::runtime_error("超过 maxItems 限制");
+          }
+          size_t count = items.size();
+          config::insert_items(arr, bulk_position(arr), std::move(items));
+          return "已导入 " + std::to_string(count) + " 项";
+        });
       }
-    };
 
-    auto on_activate = [&] {
-      // 先保存配置
-      try {
-        config::save_config(path, config);
-        status_message = "保存成功";
-      } catch (const std::exception& e) {
-        status_message = std::string("保存失败: ") + e.what();
-        show_warning("保存失败, 未激活: ", e.what());
-        return;
+      // 更新右侧面板
+      void update_right_panel() {
+        right_panel->DetachAllChildren();
+        array_buttons->DetachAllChildren();
+
+        // 添加固定组件
+        right_panel->Add(description_display);
+        if (!current_is_array && (!current_schema_ptr->contains("type") || (*current_schema_ptr)["type"] != "object")) {
+          right_panel->Add(current_value_display);
+        }
+        right_panel->Add(separator_renderer);
+
+        // 判断当前项是否为数组或对象，只有当前项既不是数组也不是对象时才显示编辑相关组件
+        if (!current_is_array && (!current_schema_ptr->contains("type") || (*current_schema_ptr)["type"] != "object")) {
+          if (selected >= 0 && selected < static_cast<int>(nodes.size())) {
+            // 布尔类型 - 显示复选框
+            if (current_schema_ptr->contains("type") && (*current_schema_ptr)["type"] == "boolean") {
+              editor_component = Checkbox("启用", &bool_value);
+            }
+            // 枚举类型 - 显示可过滤的选项列表
+            else if (current_schema_ptr->contains("enum")) {
+              editor_component = enum_picker;
+            }
+            // 长字符串 - 显示多行编辑器
+            else if (editing_long_text) {
+              editor_component = long_text_editor;
+            }
+            // 其他类型 - 显示文本输入框
+            else {
+              editor_component = Input(&edit_buffer, "编辑值");
+            }
+          } else {
+            editor_component = Input(&edit_buffer, "编辑值");
+          }
+
+          // 添加编辑器和更新按钮
+          right_panel->Add(editor_component);
+          right_panel->Add(update_button);
+        }
+        // 添加数组操作按钮
+        if (current_is_array) {
+          array_buttons->Add(add_button);
+        }
+        if (current_is_array_element) {
+          array_buttons->Add(delete_button);
+        }
+
+        if (array_buttons->ChildCount() > 0) {
+          right_panel->Add(array_buttons);
+        }
+        if (current_is_array) {
+          right_panel->Add(bulk_panel);
+        }
       }
 
-      // 保存成功后激活配置
-      try {
-        config::validate_config(config, schema);
-        config::set_active_config(path);
-        status_message = "已设为激活配置";
-      } catch (const std::exception& e) {
-        show_warning("校验失败: ", e.what());
+      void on_save() {
+        if (!hashes.dirty() && fs::exists(path)) {
+          status_message = "没有修改，无需保存";
+          return;
+        }
+        try {
+          config::save_config(path, config);
+          hashes.mark_clean();
+          status_message = "保存成功";
+        } catch (const std::exception& e) {
+          status_message = std::string("保存失败: ") + e.what();
+        }
       }
-    };
 
-    auto on_delete = [&] {
-      if (confirm_dialog("确认删除", "是否删除该配置文件？")) {
-        std::string active_config;
+      void on_activate() {
+        // 先保存配置（内容与磁盘一致时跳过写入）
+        if (hashes.dirty() || !fs::exists(path)) {
+          try {
+            config::save_config(path, config);
+            hashes.mark_clean();
+            status_message = "保存成功";
+          } catch (const std::exception& e) {
+            status_message = std::string("保存失败: ") + e.what();
+            nav.warn("保存失败, 未激活: ", e.what());
+            return;
+          }
+        }
+
+        // 保存成功后激活配置，内容未变化时不重复校验（分层配置校验合并结果）
         try {
-          active_config = config::get_active_config_path();
+          if (config::is_layered(config)) {
+            config::validate_config(config::load_merged_config(path), schema);
+          } else if (!validated || validated_hash != hashes.root()) {
+            config::validate_config(config, schema);
+            validated_hash = hashes.root();
+            validated = true;
+          }
+          config::set_active_config(path);
+          status_message = "已设为激活配置";
         } catch (const std::exception& e) {
-          // 忽略
+          nav.warn("校验失败: ", e.what());
         }
-        if (!active_config.empty() && fs::exists(active_config) && fs::equivalent(path, active_config)) {
-          config::remove_active_config_link();
+      }
+
+      void on_delete() {
+        if (nav.confirm("确认删除", "是否删除该配置文件？")) {
+          std::string active_config;
+          try {
+            active_config = config::get_active_config_path();
+          } catch (const std::exception& e) {
+            // 忽略
+          }
+          if (!active_config.empty() && fs::exists(active_config) && fs::equivalent(path, active_config)) {
+            config::remove_active_config_link();
+          }
+          fs::remove(path);
+          nav.show_main();
         }
-        fs::remove(path);
-        screen.Exit();
-        run_main_ui(app_name, schema);
       }
-    };
 
-    auto buttons = Container::Horizontal({
-      Button("保存配置", on_save),
-      Button("激活配置", on_activate),
-      Button("删除配置", on_delete),
-      Button("返回", [&] {
-        screen.Exit();
-        run_main_ui(app_name, schema);
-      })
-    });
-
-    // 修复：使用正确的容器结构
-    auto main_container = Container::Vertical({
-      layout,
-      buttons
-    });
-
-    auto main_renderer = Renderer(main_container, [&] {
-      // 当选中项变化时更新右侧面板
-      static int last_selected = -1;
-      if (selected != last_selected) {
+      Element render() {
+        stats.begin_frame();
+
+        // 选中项变化后才重建右侧面板
+        if (right_panel_dirty) {
           update_right_panel();
-          last_selected = selected;
+          right_panel_dirty = false;
+        }
+
+        auto document = vbox({
+          text(hashes.dirty() ? "配置编辑器 [未保存]" : "配置编辑器") | bold | center,
+          separator(),
+          hbox({
+            // 左侧面板
+            vbox({
+              text("设置项") | bold,
+              search_input->Render(),
+              separator(),
+              stats.section("menu", menu->Render()
+                | vscroll_indicator
+                | frame
+                | size(HEIGHT, LESS_THAN, 20))
+            }) | border
+              | size(WIDTH, EQUAL, left_panel_width + 4),
+
+            // 右侧面板
+            vbox({
+              text("详情") | bold,
+              separator(),
+              stats.section("right_panel", right_panel->Render()
+                | size(WIDTH, EQUAL, right_panel_width)) // 限制实际内容宽度
+            }) | border
+              | size(WIDTH, EQUAL, right_panel_width + 4)
+          }),
+          separator(),
+          buttons->Render() | center,
+          text(status_message) | color(Color::Yellow),
+          stats.overlay_enabled() ? stats.overlay() : emptyElement()
+        }) | border;
+        return stats.end_frame(document);
       }
 
-      return vbox({
-        text("配置编辑器") | bold | center,
-        separator(),
-        hbox({
-          // 左侧面板
-          vbox({
-            text("设置项") | bold,
-            separator(),
-            menu->Render()
-              | vscroll_indicator
-              | frame
-              | size(HEIGHT, LESS_THAN, 20)
-          }) | border
-            | size(WIDTH, EQUAL, left_panel_width + 4),
+      navigator& nav;
+      const json& schema;
+      std::string path;
+      config::document doc;  // 配置 DOM 在独立内存区中，视图释放时整体归还
+      json& config;
+
+      config::tree_hash hashes;
+      uint64_t validated_hash = 0;
+      bool validated = false;
+
+      std::string status_message;
+      std::string description;
+      std::string edit_buffer;
+      bool bool_value = false;
+
+      // 枚举选择：每个带 enum 的子 schema 建一次索引
+      std::unordered_map<const json*, std::unique_ptr<enum_index>> enum_indexes;
+      enum_picker_state enum_state;
+
+      // 派生状态的脏标记：只在输入变化时重算，而不是每帧重算
+      bool right_panel_dirty = true;    // 右侧面板结构（依赖选中项的 schema）
+      bool description_dirty = true;    // 描述的换行结果
+      bool value_text_dirty = true;     // 当前值的显示文本
+      std::vector<Element> description_lines;
+      std::string value_text;
+      frame_stats stats{"edit"};
+
+      node_table nodes;  // 菜单每行对应的配置节点，行号即节点句柄
+      std::vector<std::string> menu_items;
+      int selected = 0;
+
+      // 搜索：索引随编辑增量更新，菜单只显示匹配的行
+      search_index index;
+      std::string search_query;
+      std::vector<int> visible_rows;
+      std::vector<std::string> visible_items;
+      int menu_selected = 0;
+
+      // 存储当前选中的schema信息
+      const json* current_schema_ptr;
+      bool current_is_array = false;
+      bool current_is_array_element = false;
+      int current_min_items = 0;
+
+      // 长字符串的多行编辑
+      text_buffer long_text;
+      bool editing_long_text = false;
+      bool long_text_modified = false;
+
+      // 数组批量操作的输入
+      std::string bulk_range;
+      std::string bulk_count;
+      std::string bulk_target;
+      std::string bulk_import;
+
+      // 固定左右面板大小
+      int left_panel_width = 50; // 左侧面板宽度
+      int right_panel_width = 60; // 右侧面板宽度
+
+      Component menu;
+      Component search_input;
+      Component update_button;
+      Component add_button;
+      Component delete_button;
+      Component description_display;
+      Component current_value_display;
+      Component separator_renderer;
+      Component editor_component;
+      std::shared_ptr<text_editor> long_text_editor;
+      Component enum_picker;
+      Component right_panel;
+      Component array_buttons;
+      Component bulk_panel;
+      Component bulk_range_input;
+      Component bulk_count_input;
+      Component bulk_target_input;
+      Component bulk_import_input;
+      Component bulk_buttons;
+      Component buttons;
+    };
 
-          // 右侧面板
-          vbox({
-            text("详情") | bold,
-            separator(),
-            right_panel->Render()
-              | size(WIDTH, EQUAL, right_panel_width) // 限制实际内容宽度
-          }) | border
-            | size(WIDTH, EQUAL, right_panel_width + 4)
-        }),
-        separator(),
-        buttons->Render() | center,
-        text(status_message) | color(Color::Yellow)
-      }) | border;
-    });
-
-    screen.Loop(main_renderer);
+  }  // namespace
+
+  Component make_edit_view(navigator& nav, const std::string& path) {
+    return Make<edit_view>(nav, path);
+  }
+
+  void edit_config(const std::string& path, const std::string& app_name, const config::json& schema) {
+    navigator nav(app_name, schema);
+    nav.show_editor(path);
+    nav.run();
   }
 
-}  // namespace ui
\ No newline at end of file
+}  // namespace ui
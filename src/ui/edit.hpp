@@ -1,9 +1,16 @@
+#pragma once
+
+#include <ftxui/component/component_base.hpp>
 #include "../config.h"
 
 
 namespace ui {
+    class navigator;
 
-    // 编辑配置界面
+    // 编辑配置界面（单独启动导航器，返回后回到主界面）
     void edit_config(const std::string& filepath, const std::string& app_name, const config::json& schema);
 
+    // 编辑界面视图（由 navigator 切换）
+    ftxui::Component make_edit_view(navigator& nav, const std::string& filepath);
+
 }  // namespace ui
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include "enum_picker.hpp"
+#include "../config/schema_program.hpp"
+#include <ftxui/component/component.hpp>
+#include <ftxui/component/event.hpp>
+#include <ftxui/component/mouse.hpp>
+#include <ftxui/dom/elements.hpp>
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+using namespace ftxui;
+
+namespace ui {
+
+  namespace {
+
+    std::string fold(std::string s) {
+      std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+      return s;
+    }
+
+    class enum_list : public ComponentBase {
+    public:
+      enum_list(enum_picker_state* state, int rows, int width)
+          : state_(state), rows_(std::max(1, rows)), width_(std::max(10, width)) {}
+
+      Element OnRender() override {
+        const auto& matches = state_->matches;
+        const int count = static_cast<int>(matches.size());
+        if (state_->cursor < top_) top_ = state_->cursor;
+        if (state_->cursor >= top_ + rows_) top_ = state_->cursor - rows_ + 1;
+        top_ = std::max(0, std::min(top_, count - rows_));
+
+        const bool focused = Focused();
+        Elements rows;
+        for (int i = top_; i < count && i < top_ + rows_; ++i) {
+          int option = matches[i];
+          std::string mark = option == state_->selected ? "(*) " : "( ) ";
+          Element row = text(mark + state_->index->label(option));
+          if (i == state_->cursor) row = focused ? row | inverted : row | bold;
+          rows.push_back(row);
+        }
+        if (count == 0) rows.push_back(text("无匹配项") | dim);
+
+        std::string status = std::to_string(count) + " / " + std::to_string(state_->index->size()) + " 项";
+        return vbox({
+          vbox(std::move(rows)) | size(HEIGHT, EQUAL, rows_),
+          text(status) | dim,
+        }) | size(WIDTH, EQUAL, width_) | reflect(box_);
+      }
+
+      bool OnEvent(Event event) override {
+        if (event.is_mouse()) return on_mouse(event);
+        if (!Focused()) return false;
+
+        const int count = static_cast<int>(state_->matches.size());
+        int cursor = state_->cursor;
+        if (event == Event::ArrowUp) {
+          if (cursor == 0) return false;  // 让焦点回到过滤输入框
+          --cursor;
+        } else if (event == Event::ArrowDown) {
+          if (cursor + 1 >= count) return false;
+          ++cursor;
+        } else if (event == Event::PageUp) {
+          cursor = std::max(0, cursor - rows_);
+        } else if (event == Event::PageDown) {
+          cursor = std::max(0, std::min(count - 1, cursor + rows_));
+        } else if (event == Event::Home) {
+          cursor = 0;
+        } else if (event == Event::End) {
+          cursor = std::max(0, count - 1);
+        } else if (event == Event::Return || event == Event::Character(' ')) {
+          // 光标移动已经选中，这里仅吞掉事件
+        } else {
+          return false;
+        }
+        move_to(cursor);
+        return true;
+      }
+
+      bool Focusable() const override { return !state_->matches.empty(); }
+
+    private:
+      bool on_mouse(Event& event) {
+        if (!box_.Contain(event.mouse().x, event.mouse().y)) return false;
+        const int count = static_cast<int>(state_->matches.size());
+        if (event.mouse().button == Mouse::WheelUp) {
+          move_to(std::max(0, state_->cursor - 3));
+          return true;
+        }
+        if (event.mouse().button == Mouse::WheelDown) {
+          move_to(std::max(0, std::min(count - 1, state_->cursor + 3)));
+          return true;
+        }
+        if (event.mouse().button == Mouse::Left && event.mouse().motion == Mouse::Pressed) {
+          TakeFocus();
+          int row = top_ + (event.mouse().y - box_.y_min);
+          if (row >= 0 && row < count && row < top_ + rows_) move_to(row);
+          return true;
+        }
+        return false;
+      }
+
+      void move_to(int cursor) {
+        if (state_->matches.empty()) return;
+        state_->cursor = cursor;
+        state_->selected = state_->matches[cursor];
+      }
+
+      enum_picker_state* state_;
+      int rows_;
+      int width_;
+      int top_ = 0;
+      Box box_;
+    };
+
+  }  // namespace
+
+  enum_index::enum_index(const config::json& values) {
+    values_.reserve(values.size());
+    labels_.reserve(values.size());
+    folded_.reserve(values.size());
+    for (const auto& value : values) {
+      int i = static_cast<int>(values_.size());
+      values_.push_back(value);
+      labels_.push_back(value.is_string() ? value.get<std::string>() : value.dump());
+      folded_.push_back(fold(labels_.back()));
+      by_hash_.emplace(config::value_hash(value), i);
+    }
+  }
+
+  int enum_index::find(const config::json& value) const {
+    auto range = by_hash_.equal_range(config::value_hash(value));
+    int found = -1;
+    for (auto it = range.first; it != range.second; ++it) {
+      // 重复的选项取第一个
+      if (values_[it->second] == value && (found < 0 || it->second < found)) found = it->second;
+    }
+    return found;
+  }
+
+  std::vector<int> enum_index::filter(const std::string& query) const {
+    std::vector<std::string> terms;
+    std::istringstream words(fold(query));
+    for (std::string word; words >> word;) terms.push_back(word);
+
+    std::vector<int> result;
+    result.reserve(terms.empty() ? values_.size() : 0);
+    for (int i = 0; i < static_cast<int>(folded_.size()); ++i) {
+      bool match = std::all_of(terms.begin(), terms.end(),
+                               [&](const std::string& term) { return folded_[i].find(term) != std::string::npos; });
+      if (match) result.push_back(i);
+    }
+    return result;
+  }
+
+  void enum_picker_state::reset(const enum_index* new_index, int new_selected) {
+    index = new_index;
+    selected = new_selected;
+    query.clear();
+    refilter();
+  }
+
+  void enum_picker_state::refilter() {
+    matches = index ? index->filter(query) : std::vector<int>{};
+    auto it = std::lower_bound(matches.begin(), matches.end(), selected);
+    cursor = it != matches.end() && *it == selected ? static_cast<int>(it - matches.begin()) : 0;
+  }
+
+  Component make_enum_picker(enum_picker_state* state, int rows, int width) {
+    InputOption option;
+    option.on_change = [state] { state->refilter(); };
+    auto filter = Input(&state->query, "过滤选项", option);
+    auto list = Make<enum_list>(state, rows, width);
+    return Container::Vertical({filter, list});
+  }
+
+}  // namespace ui
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <ftxui/component/component_base.hpp>
+#include "../config/json_type.hpp"
+
+namespace ui {
+
+  // 某个子 schema 的 enum 选项索引，构建一次后在多次选中之间复用
+  // 选项可以是任意 JSON 值：字符串显示原文，其他值显示 dump() 的结果。
+  class enum_index {
+  public:
+    explicit enum_index(const config::json& values);
+
+    size_t size() const { return values_.size(); }
+    const config::json& value(int i) const { return values_[i]; }
+    const std::string& label(int i) const { return labels_[i]; }
+
+    // 与 value 相等（数值 1 与 1.0 相等）的选项下标，没有时返回 -1
+    int find(const config::json& value) const;
+
+    // 以空格分隔的每个词都作为子串出现在标签中（不区分大小写）的选项下标，按 enum 中的顺序排列
+    std::vector<int> filter(const std::string& query) const;
+
+  private:
+    std::vector<config::json> values_;
+    std::vector<std::string> labels_;
+    std::vector<std::string> folded_;  // 小写标签
+    std::unordered_multimap<uint64_t, int> by_hash_;
+  };
+
+  // 枚举选择器的状态，由编辑界面持有
+  struct enum_picker_state {
+    const enum_index* index = nullptr;
+    int selected = -1;               // 选中的选项下标，-1 表示当前值不在 enum 中
+    std::string query;
+    std::vector<int> matches;        // 过滤后的选项下标
+    int cursor = 0;                  // matches 中的光标位置
+
+    // 切换到另一组选项（或重新选中）时调用
+    void reset(const enum_index* new_index, int new_selected);
+
+    // 按 query 重新过滤，光标尽量留在选中项上
+    void refilter();
+  };
+
+  // 可过滤的枚举选择器：上方输入过滤词，下方列表只渲染可见的 rows 行。
+  // 在列表中移动光标或点击即改变 state->selected。
+  ftxui::Component make_enum_picker(enum_picker_state* state, int rows, int width);
+
+}  // namespace ui
@@ -0,0 +1,123 @@
+#include "frame_stats.hpp"
+#include <ftxui/dom/node.hpp>
+#include <cstdlib>
+#include <cstdio>
+
+using namespace ftxui;
+
+namespace ui {
+
+  namespace {
+
+    using steady = std::chrono::steady_clock;
+
+    double elapsed_ms(steady::time_point since) {
+      return std::chrono::duration<double, std::milli>(steady::now() - since).count();
+    }
+
+    std::string format_ms(double ms) {
+      char buf[32];
+      std::snprintf(buf, sizeof(buf), "%.2fms", ms);
+      return buf;
+    }
+
+  }  // namespace
+
+  // 透明包装节点：把布局、绘制转发给子节点并计时
+  // name 为空表示根节点，绘制结束时结束整帧
+  class timed_node : public Node {
+  public:
+    timed_node(Element child, frame_stats* stats, std::shared_ptr<frame_timing> timing, std::string name)
+        : Node({std::move(child)}), stats_(stats), timing_(std::move(timing)), name_(std::move(name)) {}
+
+    void ComputeRequirement() override {
+      auto start = steady::now();
+      children_[0]->ComputeRequirement();
+      requirement_ = children_[0]->requirement();
+      add_layout(elapsed_ms(start));
+    }
+
+    void SetBox(Box box) override {
+      auto start = steady::now();
+      Node::SetBox(box);
+      children_[0]->SetBox(box);
+      add_layout(elapsed_ms(start));
+    }
+
+    void Render(Screen& screen) override {
+      auto start = steady::now();
+      children_[0]->Render(screen);
+      double ms = elapsed_ms(start);
+      if (name_.empty()) {
+        timing_->render_ms += ms;
+        if (stats_->current_ == timing_) stats_->finish();
+      } else {
+        timing_->sections[name_] += ms;
+      }
+    }
+
+  private:
+    void add_layout(double ms) {
+      if (name_.empty()) timing_->layout_ms += ms;
+      else timing_->sections[name_] += ms;
+    }
+
+    frame_stats* stats_;
+    std::shared_ptr<frame_timing> timing_;
+    std::string name_;
+  };
+
+  frame_stats::frame_stats(std::string view_name) : view_name_(std::move(view_name)) {
+    const char* overlay = std::getenv("CONFIGMANAGER_FRAME_STATS");
+    overlay_ = overlay && overlay[0] != '\0' && std::string(overlay) != "0";
+    const char* log_path = std::getenv("CONFIGMANAGER_FRAME_LOG");
+    if (log_path && log_path[0] != '\0') {
+      log_.open(log_path, std::ios::app);
+    }
+  }
+
+  void frame_stats::begin_frame() {
+    if (!enabled()) return;
+    current_ = std::make_shared<frame_timing>();
+    build_start_ = steady::now();
+  }
+
+  Element frame_stats::section(const std::string& name, Element element) {
+    if (!current_) return element;
+    return std::make_shared<timed_node>(std::move(element), this, current_, name);
+  }
+
+  Element frame_stats::end_frame(Element element) {
+    if (!current_) return element;
+    current_->build_ms = elapsed_ms(build_start_);
+    return std::make_shared<timed_node>(std::move(element), this, current_, "");
+  }
+
+  Element frame_stats::overlay() const {
+    std::string line = "build " + format_ms(last_.build_ms) +
+                       " | layout " + format_ms(last_.layout_ms) +
+                       " | render " + format_ms(last_.render_ms);
+    for (const auto& [name, ms] : last_.sections) {
+      line += " | " + name + " " + format_ms(ms);
+    }
+    return text(line) | dim;
+  }
+
+  void frame_stats::finish() {
+    last_ = *current_;
+    current_.reset();
+    ++frame_count_;
+    if (log_.is_open()) {
+      log_ << view_name_ << " frame=" << frame_count_
+           << " build_ms=" << last_.build_ms
+           << " layout_ms=" << last_.layout_ms
+           << " render_ms=" << last_.render_ms;
+      for (const auto& [name, ms] : last_.sections) {
+        log_ << " " << name << "_ms=" << ms;
+      }
+      log_ << "\n";
+      log_.flush();
+    }
+  }
+
+}  // namespace ui
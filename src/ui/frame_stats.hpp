@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <ftxui/dom/elements.hpp>
+
+namespace ui {
+
+  // 单帧耗时（毫秒）
+  struct frame_timing {
+    double build_ms = 0;   // Renderer 中构建元素树
+    double layout_ms = 0;  // ComputeRequirement + SetBox
+    double render_ms = 0;  // 绘制到屏幕缓冲
+    std::map<std::string, double> sections;  // 各面板的布局+绘制耗时
+  };
+
+  // 每帧耗时统计
+  // 环境变量 CONFIGMANAGER_FRAME_STATS=1 时在界面底部显示上一帧的耗时，
+  // CONFIGMANAGER_FRAME_LOG=<文件> 时每帧向该文件追加一行记录。都未设置时不做任何计时。
+  class frame_stats {
+  public:
+    explicit frame_stats(std::string view_name);
+
+    bool enabled() const { return overlay_ || log_.is_open(); }
+    bool overlay_enabled() const { return overlay_; }
+
+    // 在 Renderer 开头调用
+    void begin_frame();
+
+    // 包装某个面板的元素，单独统计它的布局和绘制耗时
+    ftxui::Element section(const std::string& name, ftxui::Element element);
+
+    // 包装根元素，绘制完成时结束这一帧
+    ftxui::Element end_frame(ftxui::Element element);
+
+    // 上一帧耗时的单行显示
+    ftxui::Element overlay() const;
+
+    const frame_timing& last() const { return last_; }
+
+  private:
+    void finish();
+
+    std::string view_name_;
+    bool overlay_ = false;
+    std::ofstream log_;
+    unsigned long frame_count_ = 0;
+    std::chrono::steady_clock::time_point build_start_;
+    std::shared_ptr<frame_timing> current_;
+    frame_timing last_;
+
+    friend class timed_node;
+  };
+
+}  // namespace ui
@@ -0,0 +1,116 @@
+#include "history_view.hpp"
+#include "navigator.hpp"
+#include "../config.h"
+#include <ftxui/component/component.hpp>
+#include <ftxui/dom/elements.hpp>
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+
+using namespace ftxui;
+namespace fs = std::filesystem;
+
+namespace ui {
+
+    namespace {
+
+        std::string event_label(const std::string& event) {
+            if (event == "save") return "保存";
+            if (event == "activate") return "激活";
+            if (event == "rollback") return "回滚";
+            return event;
+        }
+
+        std::string format_time(int64_t seconds) {
+            std::time_t t = static_cast<std::time_t>(seconds);
+            std::tm tm{};
+        #ifdef _WIN32
+            localtime_s(&tm, &t);
+        #else
+            localtime_r(&t, &tm);
+        #endif
+            std::ostringstream oss;
+            oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
+            return oss.str();
+        }
+
+        // 历史视图：只读取日志，不加载任何版本内容；回滚时才物化（已物化的版本直接改指向）
+        class history_view : public ComponentBase {
+        public:
+            explicit history_view(navigator& owner) : nav(owner) {
+                menu = Menu(&labels, &selected);
+                auto buttons = Container::Horizontal({
+                    Button("回滚激活到此版本", [this] { on_rollback(); }),
+                    Button("返回", [this] { nav.show_main(); })
+                });
+
+                auto layout = Container::Vertical({ menu, buttons });
+
+                Add(Renderer(layout, [this, buttons] {
+                    return vbox({
+                        text("版本历史 - " + nav.app_name()) | bold | center,
+                        separator(),
+                        window(text("记录 (" + std::to_string(entries.size()) + ")") | bold,
+                               menu->Render() | vscroll_indicator | frame | size(HEIGHT, LESS_THAN, 20)),
+                        separator(),
+                        buttons->Render() | center,
+                        text(status_message) | color(Color::Yellow),
+                        filler(),
+                    }) | border;
+                }));
+
+                reload();
+            }
+
+        private:
+            void reload() {
+                try {
+                    entries = config::default_version_store().list();
+                } catch (const std::exception& e) {
+                    entries.clear();
+                    status_message = std::string("读取历史失败: ") + e.what();
+                }
+                // 最新的在前
+                std::reverse(entries.begin(), entries.end());
+                labels.clear();
+                for (const auto& entry : entries) {
+                    labels.push_back("#" + std::to_string(entry.seq) + "  " + format_time(entry.time) + "  " +
+                                     event_label(entry.event) + "  " + entry.file + "  " + entry.root.substr(0, 8));
+                }
+                selected = std::clamp(selected, 0, std::max(0, static_cast<int>(entries.size()) - 1));
+            }
+
+            void on_rollback() {
+                if (selected < 0 || selected >= static_cast<int>(entries.size())) return;
+                const auto entry = entries[selected];
+                if (!nav.confirm("确认回滚", "是否将激活配置回滚到版本 #" + std::to_string(entry.seq) + "（" +
+                                             entry.file + "）？")) {
+                    return;
+                }
+                try {
+                    std::string active_link = (fs::path(config::get_default_config_dir()) / "active").string();
+                    config::default_version_store().rollback(entry, active_link);
+                    status_message = "已回滚到版本 #" + std::to_string(entry.seq);
+                } catch (const std::exception& e) {
+                    status_message = std::string("回滚失败: ") + e.what();
+                }
+                reload();
+            }
+
+            navigator& nav;
+            std::vector<config::version_entry> entries;
+            std::vector<std::string> labels;
+            std::string status_message;
+            int selected = 0;
+            Component menu;
+        };
+
+    }  // namespace
+
+    Component make_history_view(navigator& nav) {
+        return Make<history_view>(nav);
+    }
+
+}  // namespace ui
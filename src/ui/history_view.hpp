@@ -0,0 +1,11 @@
+#pragma once
+
+#include <ftxui/component/component_base.hpp>
+
+namespace ui {
+    class navigator;
+
+    // 版本历史视图（由 navigator 切换），列出保存和激活记录，可将激活配置回滚到任一版本
+    ftxui::Component make_history_view(navigator& nav);
+
+}  // namespace ui
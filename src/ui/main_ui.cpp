@@ -1,6 +1,6 @@
 #include "../utils/fs.hpp"
 #include "main_ui.hpp"
-#include "edit.hpp"
+#include "navigator.hpp"
 #include "ui_utils.hpp"
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/screen_interactive.hpp>
@@ -117,115 +117,134 @@ namespace ui {
         return result;
     }
 
-    void run_main_ui(const std::string& app_name, const config::json& schema) {
-        bool refresh = true;
-        while (refresh) {
-            refresh = false;
-            auto screen = ScreenInteractive::Fullscreen();
-
-            std::string config_dir = config::get_default_config_dir();
-            auto files = utils::filesystem::list_json_files(config_dir);
-            std::string active;
-            try {
-                active = fs::path(config::get_active_config_path()).filename().string();
-            } catch (const std::exception& e) {
-                // 忽略
-            }
-
-            std::vector<std::string> display_files;
-            for (const auto& f : files) {
-                display_files.push_back((f == active ? "* " : "  ") + f);
-            }
-
-            int selected = 0;
-
-            auto on_edit = [&] {
-                if (files.empty()) return;
-                screen.Exit();
-                ui::edit_config(config_dir + "/" + files[selected], app_name, schema);
-            };
-
-            auto on_delete = [&] {
-                if (files.empty()) return;
-                std::string target = config_dir + "/" + files[selected];
-                if (confirm_dialog("确认删除", "是否删除配置文件：" + files[selected] + "？")) {
-                    std::string active_config;
-                    try {
-                        active_config = config::get_active_config_path();
-                    } catch (const std::exception& e) {
-                        // 忽略
+    namespace {
+
+        // 主界面：配置文件列表及编辑、删除、激活、新建操作
+        class main_view : public ComponentBase {
+        public:
+            explicit main_view(navigator& owner) : nav(owner) {
+                auto on_edit = [this] {
+                    if (files.empty()) return;
+                    nav.show_editor(config_dir + "/" + files[selected]);
+                };
+
+                auto on_delete = [this] {
+                    if (files.empty()) return;
+                    std::string target = config_dir + "/" + files[selected];
+                    if (nav.confirm("确认删除", "是否删除配置文件：" + files[selected] + "？")) {
+                        std::string active_config;
+                        try {
+                            active_config = config::get_active_config_path();
+                        } catch (const std::exception& e) {
+                            // 忽略
+                        }
+                        if (!active_config.empty() && fs::exists(active_config) &&
+                            fs::equivalent(target, active_config)) {
+                            config::remove_active_config_link();
+                        }
+                        fs::remove(target);
+                        reload();
                     }
-                    if (!active_config.empty() && fs::exists(active_config) &&
-                        fs::equivalent(target, active_config)) {
-                        config::remove_active_config_link();
+                };
+
+                auto on_activate = [this] {
+                    if (files.empty()) return;
+                    if (nav.confirm("确认激活", "是否设为激活配置：" + files[selected] + "？")) {
+                        std::string target_path = config_dir + "/" + files[selected];
+                        try {
+                            auto cfg = config::load_merged_config(target_path);
+                            config::validate_config(cfg, nav.schema());
+                            config::set_active_config(target_path);
+                        } catch (const std::exception& e) {
+                            nav.warn("校验失败", "配置未通过校验，请仔细检查\n错误信息: " + std::string(e.what()));
+                        }
+                        reload();
                     }
-                    fs::remove(target);
-                    refresh = true;
-                    screen.Exit();
-                }
-            };
+                };
+
+                auto on_create = [this] {
+                    std::string filename = nav.ask_filename(files);
+                    if (!filename.empty()) {
+                        config::json new_config = config::generate_default_config(nav.schema());
+                        config::save_config(config_dir + "/" + filename, new_config);
+                        reload();
+                    }
+                };
 
-            auto on_activate = [&] {
-                if (files.empty()) return;
-                if (confirm_dialog("确认激活", "是否设为激活配置：" + files[selected] + "？")) {
-                    std::string target_path = config_dir + "/" + files[selected];
-                    try {
-                        auto cfg = config::load_config(target_path);
-                        config::validate_config(cfg, schema);
-                        config::set_active_config(target_path);
-                    } catch (const std::exception& e) {
-                        show_warning("校验失败", "配置未通过校验，请仔细检查\n错误信息: " + std::string(e.what()));
+                auto on_quit = [this] {
+                    if (nav.confirm("确认退出", "确定要退出程序吗？")) {
+                        nav.exit();
                     }
-                    refresh = true;
-                    screen.Exit();
-                }
-            };
+                };
+
+                menu = Menu(&display_files, &selected);
+                buttons = Container::Horizontal({
+                    Button("编辑配置", on_edit),
+                    Button("删除配置", on_delete),
+                    Button("激活配置", on_activate),
+                    Button("新建配置", on_create),
+                    Button("查询配置", [this] { nav.show_query(); }),
+                    Button("版本历史", [this] { nav.show_history(); }),
+                    Button("退出应用", on_quit)
+                });
+
+                auto layout = Container::Vertical({ menu, buttons });
+
+                Add(Renderer(layout, [this] {
+                    return vbox({
+                        text("配置管理器 - " + nav.app_name()) | bold | center,
+                        separator(),
+                        window(text("配置文件列表") | bold,
+                               menu->Render() | frame | size(HEIGHT, LESS_THAN, 20)),
+                        separator(),
+                        buttons->Render() | center,
+                        nav.schema_status().empty() ? emptyElement() : text(nav.schema_status()) | color(Color::Yellow),
+                        filler(),
+                    }) | border;
+                }));
+
+                reload();
+            }
 
-            auto on_create = [&] {
-                std::string filename = ask_new_filename(files);
-                if (!filename.empty()) {
-                    config::json new_config = config::generate_default_config(schema);
-                    config::save_config(config_dir + "/" + filename, new_config);
-                    refresh = true;
-                    screen.Exit();
+        private:
+            // 重新读取文件列表和激活状态
+            void reload() {
+                config_dir = config::get_default_config_dir();
+                files = utils::filesystem::list_json_files(config_dir);
+                std::string active;
+                try {
+                    active = fs::path(config::get_active_config_path()).filename().string();
+                } catch (const std::exception& e) {
+                    // 忽略
                 }
-            };
 
-            bool exit_app = false;
-            auto on_quit = [&] {
-                if (confirm_dialog("确认退出", "确定要退出程序吗？")) {
-                    exit_app = true;
-                    screen.Exit();
+                display_files.clear();
+                for (const auto& f : files) {
+                    display_files.push_back((f == active ? "* " : "  ") + f);
                 }
-            };
+                selected = std::clamp(selected, 0, std::max(0, static_cast<int>(files.size()) - 1));
+            }
 
-            auto menu = Menu(&display_files, &selected);
-            auto buttons = Container::Horizontal({
-                Button("编辑配置", on_edit),
-                Button("删除配置", on_delete),
-                Button("激活配置", on_activate),
-                Button("新建配置", on_create),
-                Button("退出应用", on_quit)
-            });
-
-            auto layout = Container::Vertical({ menu, buttons });
-
-            auto renderer = Renderer(layout, [&] {
-                return vbox({
-                    text("配置管理器 - " + app_name) | bold | center,
-                    separator(),
-                    window(text("配置文件列表") | bold,
-                           menu->Render() | frame | size(HEIGHT, LESS_THAN, 20)),
-                    separator(),
-                    buttons->Render() | center,
-                    filler(),
-                }) | border;
-            });
-
-            screen.Loop(renderer);
-
-            if (exit_app) break;
-        }
+            navigator& nav;
+            std::string config_dir;
+            std::vector<std::string> files;
+            std::vector<std::string> display_files;
+            int selected = 0;
+            Component menu;
+            Component buttons;
+        };
+
+    }  // namespace
+
+    Component make_main_view(navigator& nav) {
+        return Make<main_view>(nav);
+    }
+
+    void run_main_ui(const std::string& app_name, const config::json& schema) {
+        navigator nav(app_name, schema);
+        nav.watch_schema((fs::path(config::get_default_config_dir()).parent_path() / "schema.json").string());
+        nav.show_main();
+        nav.run();
     }
 
 }  // namespace ui
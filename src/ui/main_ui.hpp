@@ -1,8 +1,11 @@
 #include <string>
+#include <ftxui/component/component_base.hpp>
 #include "../config.h"
 
 
 namespace ui {
+    class navigator;
+
     bool confirm_dialog(const std::string& title, const std::string& message);
 
     // 显示警告对话框
@@ -11,8 +14,12 @@ namespace ui {
     // 获取新文件名（无扩展名）
     std::string ask_new_filename(const std::vector<std::string>& existing);
 
+    // 以主界面启动导航器，直到用户退出
     void run_main_ui(const std::string& app_name, const config::json& schema);
 
+    // 主界面视图（由 navigator 切换）
+    ftxui::Component make_main_view(navigator& nav);
+
     int get_terminal_width();
 
     std::vector<std::string> wrap_paragraph(const std::string& paragraph, int max_width);
@@ -0,0 +1,162 @@
+#include "navigator.hpp"
+#include "main_ui.hpp"
+#include "edit.hpp"
+#include "query_view.hpp"
+#include "history_view.hpp"
+#include "../utils/trace.hpp"
+#include <ftxui/component/event.hpp>
+#include <ftxui/dom/node.hpp>
+#include <filesystem>
+
+using namespace ftxui;
+
+namespace ui {
+
+  namespace {
+
+    // 追踪一次完整的渲染：从构建元素树开始，到绘制完成结束
+    class traced_render : public Node {
+    public:
+      traced_render(Element child, utils::trace::clock::time_point start)
+          : Node({std::move(child)}), start_(start) {}
+
+      void ComputeRequirement() override {
+        children_[0]->ComputeRequirement();
+        requirement_ = children_[0]->requirement();
+      }
+
+      void SetBox(Box box) override {
+        Node::SetBox(box);
+        children_[0]->SetBox(box);
+      }
+
+      void Render(Screen& screen) override {
+        children_[0]->Render(screen);
+        utils::trace::complete("render", "ui", start_);
+      }
+
+    private:
+      utils::trace::clock::time_point start_;
+    };
+
+    // 只持有当前视图一个子组件；每次事件处理后执行挂起的切换
+    class navigator_root : public ComponentBase {
+    public:
+      explicit navigator_root(navigator* nav) : nav_(nav) {}
+
+      Element OnRender() override {
+        if (!utils::trace::enabled()) {
+          nav_->apply_pending();
+          if (children_.empty()) return emptyElement();
+          return children_.front()->Render();
+        }
+        auto start = utils::trace::clock::now();
+        {
+          TRACE_SCOPE("apply_pending", "ui");
+          nav_->apply_pending();
+        }
+        if (children_.empty()) return emptyElement();
+        return std::make_shared<traced_render>(children_.front()->Render(), start);
+      }
+
+      bool OnEvent(Event event) override {
+        bool handled = !children_.empty() && children_.front()->OnEvent(event);
+        nav_->apply_pending();
+        return handled;
+      }
+
+    private:
+      navigator* nav_;
+    };
+
+  }  // namespace
+
+  navigator::navigator(std::string app_name, const config::json& schema)
+      : app_name_(std::move(app_name)), schema_(schema), root_(Make<navigator_root>(this)) {
+    confirm = confirm_dialog;
+    warn = show_warning;
+    ask_filename = ask_new_filename;
+  }
+
+  void navigator::show_main() {
+    pending_ = [this] { return make_main_view(*this); };
+  }
+
+  void navigator::show_editor(const std::string& path) {
+    pending_ = [this, path] { return make_edit_view(*this, path); };
+  }
+
+  void navigator::show_query() {
+    pending_ = [this] { return make_query_view(*this); };
+  }
+
+  void navigator::show_history() {
+    pending_ = [this] { return make_history_view(*this); };
+  }
+
+  void navigator::exit() {
+    exited_ = true;
+    if (screen_) screen_->Exit();
+  }
+
+  void navigator::apply_pending() {
+    if (!pending_) return;
+    auto make_view = std::move(pending_);
+    pending_ = nullptr;
+    // 先释放旧视图，再构建新视图，避免两份配置同时驻留
+    on_schema_reload = nullptr;
+    root_->DetachAllChildren();
+    root_->Add(make_view());
+  }
+
+  void navigator::run() {
+    auto screen = ScreenInteractive::Fullscreen();
+    screen_ = &screen;
+    apply_pending();
+    if (!schema_path_.empty()) {
+      // 重新加载和校验在监视线程中完成，替换 schema 投递回界面线程
+      watcher_ = std::make_unique<config::schema_watcher>(
+          schema_path_, config::get_default_config_dir(), schema_, [this, &screen](config::schema_reload reload) {
+            screen.Post([this, reload = std::move(reload)]() mutable { apply_schema(std::move(reload)); });
+            screen.PostEvent(Event::Custom);
+          });
+    }
+    if (!exited_) screen.Loop(root_);
+    watcher_.reset();
+    screen_ = nullptr;
+  }
+
+  void navigator::watch_schema(const std::string& schema_path) {
+    schema_path_ = schema_path;
+  }
+
+  void navigator::apply_schema(config::schema_reload reload) {
+    if (!reload.error.empty()) {
+      schema_status_ = "schema 重新加载失败，仍使用旧版本: " + reload.error;
+    } else {
+      // 先取消并等待监视线程中可能正在进行的下一次重新校验，再替换注册表和校验缓存
+      std::unique_lock<std::mutex> paused;
+      if (watcher_) paused = watcher_->pause();
+      config::install_schema(schema_path_, reload.schema);
+      schema_ = reload.schema;
+      if (reload.changed.empty()) {
+        schema_status_ = "schema 已重新加载：校验约束未变化";
+      } else {
+        schema_status_ = "schema 已重新加载：" + std::to_string(reload.changed.size()) + " 处约束变化，重新校验 " +
+                         std::to_string(reload.affected) + " 个配置，" +
+                         std::to_string(reload.failures.size()) + " 个未通过";
+        std::string active;
+        try {
+          active = std::filesystem::path(config::get_active_config_path()).filename().string();
+        } catch (const std::exception&) {
+          // 没有激活配置
+        }
+        for (const auto& failure : reload.failures) {
+          if (failure.first == active) schema_status_ += "（激活配置 " + active + " 未通过）";
+        }
+      }
+    }
+    if (on_schema_reload) on_schema_reload(reload);
+  }
+
+}  // namespace ui
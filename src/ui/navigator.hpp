@@ -0,0 +1,79 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <ftxui/component/component.hpp>
+#include <ftxui/component/screen_interactive.hpp>
+#include "../config.h"
+
+namespace ui {
+
+  // 顶层导航器：持有唯一的全屏 ScreenInteractive，在主界面和编辑界面之间切换视图。
+  // 切换发生在当前事件处理完成之后，旧视图（连同它加载的配置 DOM）随即释放，
+  // 不再像互相递归调用 run_main_ui / edit_config 那样在栈上层层累积。
+  class navigator {
+  public:
+    navigator(std::string app_name, const config::json& schema);
+
+    // 切换到主界面
+    void show_main();
+
+    // 切换到指定配置的编辑界面
+    void show_editor(const std::string& path);
+
+    // 切换到跨配置查询界面
+    void show_query();
+
+    // 切换到版本历史界面
+    void show_history();
+
+    // 退出主循环
+    void exit();
+
+    // 运行主循环，直到 exit()
+    void run();
+
+    // 主循环运行期间在后台监视 schema 文件，变化后在界面线程替换 schema（run 之前调用）
+    void watch_schema(const std::string& schema_path);
+
+    // 以热加载的结果替换当前 schema，并通知当前视图
+    void apply_schema(config::schema_reload reload);
+
+    // 最近一次热加载的摘要（未发生过时为空）
+    const std::string& schema_status() const { return schema_status_; }
+
+    // 根组件（不启动主循环时可直接向其发送事件并渲染）
+    ftxui::Component root() { return root_; }
+
+    // 立即执行挂起的视图切换
+    void apply_pending();
+
+    bool exited() const { return exited_; }
+
+    const std::string& app_name() const { return app_name_; }
+    // schema 热加载时原地替换，视图持有的引用保持有效，但其中子 schema 的地址会失效
+    const config::json& schema() const { return schema_; }
+
+    // 当前视图在 schema 替换后需要做的更新（切换视图时清空）
+    std::function<void(const config::schema_reload&)> on_schema_reload;
+
+    // 对话框，默认弹出 confirm_dialog / show_warning / ask_new_filename，可替换为非交互实现
+    std::function<bool(const std::string&, const std::string&)> confirm;
+    std::function<void(const std::string&, const std::string&)> warn;
+    std::function<std::string(const std::vector<std::string>&)> ask_filename;
+
+  private:
+    std::string app_name_;
+    config::json schema_;
+    std::string schema_path_;
+    std::string schema_status_;
+    std::unique_ptr<config::schema_watcher> watcher_;
+    ftxui::Component root_;
+    std::function<ftxui::Component()> pending_;
+    ftxui::ScreenInteractive* screen_ = nullptr;
+    bool exited_ = false;
+  };
+
+}  // namespace ui
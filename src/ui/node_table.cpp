@@ -0,0 +1,175 @@
+#include "node_table.hpp"
+#include <iterator>
+
+namespace ui {
+
+  using json = config::json;
+
+  void node_table::build(json& config, const json& schema) {
+    root_ = &config;
+    registry_ = config::current_schema_registry();
+    root_schema_ = &registry_->resolve(schema);
+    nodes_.clear();
+    row_of_.clear();
+    add_children(schema, &config, -1, 0);
+  }
+
+  int node_table::rebuild_children(int row) {
+    const int old_end = nodes_[row].end;
+    for (int r = row + 1; r < old_end; ++r) {
+      if (nodes_[r].value) row_of_.erase(nodes_[r].value);
+    }
+
+    // 子树之后的行先移出，重建子树后再接回
+    std::vector<node> tail(std::make_move_iterator(nodes_.begin() + old_end), std::make_move_iterator(nodes_.end()));
+    nodes_.erase(nodes_.begin() + row + 1, nodes_.end());
+    add_children(*nodes_[row].schema, nodes_[row].value, row, nodes_[row].depth + 1);
+    const int new_end = static_cast<int>(nodes_.size());
+    const int delta = new_end - old_end;
+
+    nodes_[row].end = new_end;
+    for (int r = nodes_[row].parent; r >= 0; r = nodes_[r].parent) nodes_[r].end += delta;
+    if (delta != 0) {
+      for (auto& n : tail) {
+        if (n.parent >= old_end) n.parent += delta;
+        n.end += delta;
+      }
+    }
+    nodes_.insert(nodes_.end(), std::make_move_iterator(tail.begin()), std::make_move_iterator(tail.end()));
+    if (delta != 0) {
+      for (int r = new_end; r < static_cast<int>(nodes_.size()); ++r) {
+        if (nodes_[r].value) row_of_[nodes_[r].value] = r;
+      }
+    }
+    return delta;
+  }
+
+  void node_table::add_children(const json& node_schema, json* value, int parent, int depth) {
+    const json& schema = registry_->resolve(node_schema);
+    if (!schema.contains("type")) return;
+    const std::string& type = schema["type"].get_ref<const std::string&>();
+
+    auto push = [&](std::string key, bool array_element, json* child, const json& child_schema) {
+      int row = static_cast<int>(nodes_.size());
+      nodes_.push_back({parent, row + 1, depth, array_element, std::move(key), child, &child_schema});
+      if (child) row_of_.emplace(child, row);
+      add_children(child_schema, child, row, depth + 1);
+      nodes_[row].end = static_cast<int>(nodes_.size());
+    };
+
+    if (type == "object" && schema.contains("properties")) {
+      for (auto it = schema["properties"].begin(); it != schema["properties"].end(); ++it) {
+        json* child = nullptr;
+        if (value && value->is_object()) {
+          auto found = value->find(it.key());
+          if (found != value->end()) child = &*found;
+        }
+        push(it.key(), false, child, registry_->resolve(it.value()));
+      }
+    } else if (type == "array" && schema.contains("items") && value && value->is_array()) {
+      const json& items = registry_->resolve(schema["items"]);
+      for (size_t i = 0; i < value->size(); ++i) {
+        push(std::to_string(i), true, &(*value)[i], items);
+      }
+    }
+  }
+
+  json* node_table::parent_value(int row) const {
+    int parent = nodes_[row].parent;
+    return parent < 0 ? root_ : nodes_[parent].value;
+  }
+
+  const json& node_table::parent_schema(int row) const {
+    int parent = nodes_[row].parent;
+    return parent < 0 ? *root_schema_ : *nodes_[parent].schema;
+  }
+
+  std::string node_table::pointer(int row) const {
+    std::vector<int> chain;
+    for (int r = row; r >= 0; r = nodes_[r].parent) chain.push_back(r);
+    std::string out;
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+      out += '/';
+      for (char c : nodes_[*it].key) {
+        if (c == '~') out += "~0";
+        else if (c == '/') out += "~1";
+        else out += c;
+      }
+    }
+    return out;
+  }
+
+  std::string node_table::label(int row) const {
+    const node& n = nodes_[row];
+    std::string label(n.depth * 2, ' ');
+    if (n.array_element) {
+      // 数组元素不显示值（只显示索引）
+      return label + "[" + n.key + "]";
+    }
+    label += n.key;
+
+    // 获取当前值（如果是基本类型）
+    std::string value_str;
+    if (n.value) {
+      const json& val = *n.value;
+      if (n.schema->contains("type")) {
+        std::string prop_type = (*n.schema)["type"];
+        if (prop_type != "object" && prop_type != "array") {
+          if (prop_type == "boolean") {
+            value_str = val.get<bool>() ? "true" : "false";
+          } else if (prop_type == "string") {
+            // 只取开头一段，长字符串不整体复制
+            const auto& s = val.get_ref<const std::string&>();
+            value_str = "\"" + s.substr(0, 16) + (s.size() > 16 ? "\"..." : "\"");
+          } else {
+            value_str = val.dump();
+          }
+        }
+      } else {
+        value_str = val.dump();
+      }
+    }
+
+    // 如果值太长，截断
+    if (value_str.length() > 15) {
+      value_str = value_str.substr(0, 12) + "...";
+    }
+    return value_str.empty() ? label : label + ": " + value_str;
+  }
+
+  int node_table::find(const std::string& pointer) const {
+    if (!root_) return -1;
+    json::json_pointer ptr;
+    try {
+      ptr = json::json_pointer(pointer);
+    } catch (const std::exception&) {
+      return -1;  // 不是合法的 JSON Pointer
+    }
+    const json& root = *root_;
+    if (root.contains(ptr)) return find(&root.at(ptr));
+
+    // 配置中尚不存在的键：沿兄弟节点逐级查找
+    std::vector<std::string> tokens;
+    for (auto p = ptr; !p.empty(); p.pop_back()) tokens.push_back(p.back());
+    int begin = 0, end = static_cast<int>(nodes_.size()), row = -1;
+    for (auto token = tokens.rbegin(); token != tokens.rend(); ++token) {
+      row = -1;
+      for (int r = begin; r < end; r = nodes_[r].end) {
+        if (nodes_[r].key == *token) {
+          row = r;
+          break;
+        }
+      }
+      if (row < 0) return -1;
+      begin = row + 1;
+      end = nodes_[row].end;
+    }
+    return row;
+  }
+
+  int node_table::find(const json* value) const {
+    auto it = row_of_.find(value);
+    return it == row_of_.end() ? -1 : it->second;
+  }
+
+}  // namespace ui
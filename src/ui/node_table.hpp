@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../config.h"
+
+namespace ui {
+
+  // 编辑器左侧菜单的节点表：每行对应配置中的一个节点，按菜单顺序（先序）平铺存放，行号即节点句柄。
+  // 键只存一份，父子关系用行号表示，子树占据连续的行 [row + 1, end)。
+  // value / schema 直接指向配置和 schema 中的节点，取值是 O(1) 解引用，不再从根逐级查找；
+  // 配置结构变化（增删数组项、替换对象或数组）后指针可能失效，需要 build() 重建。
+  class node_table {
+  public:
+    struct node {
+      int parent;                  // 父节点行，-1 表示根对象
+      int end;                     // 子树结束行（不含）
+      int depth;
+      bool array_element;          // key 为数组下标
+      std::string key;
+      config::json* value;         // 配置中不存在该键时为 nullptr
+      const config::json* schema;  // 已解析 $ref 的子 schema
+    };
+
+    // 按 schema 展开配置：对象按 schema 的 properties 列出，数组按配置中的实际元素列出
+    void build(config::json& config, const config::json& schema);
+
+    // 只重建 row 的子树（row 自身的值仍有效，如增删了数组元素）：新行替换 [row + 1, end)，
+    // 之后各行整体平移，键不再复制、schema 不再解析。返回子树行数的变化量
+    int rebuild_children(int row);
+
+    size_t size() const { return nodes_.size(); }
+    bool empty() const { return nodes_.empty(); }
+    const node& operator[](int row) const { return nodes_[row]; }
+
+    // 父节点的值与 schema（根对象的父节点即配置和 schema 本身）
+    config::json* parent_value(int row) const;
+    const config::json& parent_schema(int row) const;
+
+    // 行对应的 JSON Pointer 字符串
+    std::string pointer(int row) const;
+
+    // 菜单文本：缩进 + 键（或 [下标]）+ 基本类型值的预览
+    std::string label(int row) const;
+
+    // JSON Pointer 字符串所在的行，不在表中时返回 -1
+    int find(const std::string& pointer) const;
+
+    // 节点所在的行，不在表中时返回 -1
+    int find(const config::json* value) const;
+
+  private:
+    void add_children(const config::json& node_schema, config::json* value, int parent, int depth);
+
+    // 节点的 schema 指针可能指向注册表快照中的引用文档，持有快照保证它们在表重建前有效
+    std::shared_ptr<const config::registry_snapshot> registry_;
+    config::json* root_ = nullptr;
+    const config::json* root_schema_ = nullptr;
+    std::vector<node> nodes_;
+    std::unordered_map<const config::json*, int> row_of_;
+  };
+
+}  // namespace ui
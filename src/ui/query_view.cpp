@@ -0,0 +1,95 @@
+#include "query_view.hpp"
+#include "navigator.hpp"
+#include "../config.h"
+#include <ftxui/component/component.hpp>
+#include <ftxui/dom/elements.hpp>
+#include <filesystem>
+
+using namespace ftxui;
+namespace fs = std::filesystem;
+
+namespace ui {
+
+    namespace {
+
+        // 查询视图：输入表达式，列出命中的配置文件、路径和值
+        class query_view : public ComponentBase {
+        public:
+            explicit query_view(navigator& owner)
+                : nav(owner), index(config::get_default_config_dir()) {
+                try {
+                    index.update();
+                } catch (const std::exception& e) {
+                    status_message = std::string("索引更新失败: ") + e.what();
+                }
+
+                InputOption input_option;
+                input_option.on_enter = [this] { run_query(); };
+                input = Input(&expression, "例如 /db/pool_size>64 或 example.com", input_option);
+
+                results_menu = Menu(&result_labels, &selected);
+                auto buttons = Container::Horizontal({
+                    Button("查询", [this] { run_query(); }),
+                    Button("编辑所选", [this] {
+                        if (selected >= 0 && static_cast<size_t>(selected) < hits.size()) {
+                            nav.show_editor(config::get_default_config_dir() + "/" + hits[selected].file);
+                        }
+                    }),
+                    Button("返回", [this] { nav.show_main(); })
+                });
+
+                auto layout = Container::Vertical({ input, results_menu, buttons });
+
+                Add(Renderer(layout, [this, buttons] {
+                    return vbox({
+                        text("配置查询 - " + nav.app_name()) | bold | center,
+                        separator(),
+                        hbox({ text("表达式: "), input->Render() }),
+                        separator(),
+                        window(text("结果 (" + std::to_string(hits.size()) + ")") | bold,
+                               results_menu->Render() | vscroll_indicator | frame | size(HEIGHT, LESS_THAN, 20)),
+                        separator(),
+                        buttons->Render() | center,
+                        text(status_message) | color(Color::Yellow),
+                        filler(),
+                    }) | border;
+                }));
+            }
+
+        private:
+            void run_query() {
+                try {
+                    index.update();
+                    hits = index.query(expression);
+                    status_message.clear();
+                } catch (const std::exception& e) {
+                    hits.clear();
+                    status_message = std::string("查询失败: ") + e.what();
+                }
+                result_labels.clear();
+                for (const auto& hit : hits) {
+                    std::string value = hit.value.dump();
+                    if (value.size() > 40) value = value.substr(0, 37) + "...";
+                    result_labels.push_back(hit.file + "  " + hit.pointer + " = " + value);
+                }
+                selected = 0;
+            }
+
+            navigator& nav;
+            config::config_index index;
+            std::string expression;
+            std::string status_message;
+            std::vector<config::index_hit> hits;
+            std::vector<std::string> result_labels;
+            int selected = 0;
+            Component input;
+            Component results_menu;
+        };
+
+    }  // namespace
+
+    Component make_query_view(navigator& nav) {
+        return Make<query_view>(nav);
+    }
+
+}  // namespace ui
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <ftxui/component/component_base.hpp>
+
+namespace ui {
+    class navigator;
+
+    // 跨配置查询视图（由 navigator 切换），使用应用目录下的倒排索引
+    ftxui::Component make_query_view(navigator& nav);
+
+}  // namespace ui
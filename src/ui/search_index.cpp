@@ -0,0 +1,118 @@
+#include "search_index.hpp"
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+namespace ui {
+
+  namespace {
+
+    std::string to_lower(const std::string& s) {
+      std::string out = s;
+      for (auto& c : out) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+      return out;
+    }
+
+    uint32_t trigram_at(const std::string& s, size_t i) {
+      return (static_cast<uint32_t>(static_cast<unsigned char>(s[i])) << 16) |
+             (static_cast<uint32_t>(static_cast<unsigned char>(s[i + 1])) << 8) |
+             static_cast<uint32_t>(static_cast<unsigned char>(s[i + 2]));
+    }
+
+  }  // namespace
+
+  void search_index::insert(const std::string& pointer) {
+    auto [it, inserted] = by_pointer_.emplace(pointer, static_cast<uint32_t>(texts_.size()));
+    if (!inserted) return;
+    texts_.push_back(to_lower(pointer));
+    pointers_.push_back(&it->first);
+    add_postings(it->second);
+  }
+
+  void search_index::add_postings(uint32_t id) {
+    const std::string& text = texts_[id];
+    for (size_t i = 0; i + 3 <= text.size(); ++i) {
+      auto& list = postings_[trigram_at(text, i)];
+      if (list.empty() || list.back() != id) list.push_back(id);
+    }
+  }
+
+  void search_index::erase_children(const std::string& pointer) {
+    std::string prefix = pointer + "/";
+    auto it = by_pointer_.lower_bound(prefix);
+    while (it != by_pointer_.end() && it->first.compare(0, prefix.size(), prefix) == 0) {
+      // 倒排表中的 id 延迟清理，搜索时跳过
+      pointers_[it->second] = nullptr;
+      texts_[it->second].clear();
+      ++dead_;
+      it = by_pointer_.erase(it);
+    }
+    if (dead_ > 1024 && dead_ > by_pointer_.size()) compact();
+  }
+
+  void search_index::clear() {
+    by_pointer_.clear();
+    texts_.clear();
+    pointers_.clear();
+    postings_.clear();
+    dead_ = 0;
+  }
+
+  // 删除的条目过多时重新编号并重建倒排表
+  void search_index::compact() {
+    texts_.clear();
+    pointers_.clear();
+    postings_.clear();
+    dead_ = 0;
+    for (auto it = by_pointer_.begin(); it != by_pointer_.end(); ++it) {
+      it->second = static_cast<uint32_t>(texts_.size());
+      texts_.push_back(to_lower(it->first));
+      pointers_.push_back(&it->first);
+      add_postings(it->second);
+    }
+  }
+
+  bool search_index::contains(const std::string& pointer) const {
+    return by_pointer_.count(pointer) > 0;
+  }
+
+  std::vector<std::string> search_index::search(const std::string& query) const {
+    std::vector<std::string> terms;
+    std::istringstream iss(to_lower(query));
+    for (std::string term; iss >> term;) terms.push_back(term);
+    if (terms.empty()) return {};
+
+    // 最长的词最有区分度，取它最短的倒排表作为候选集
+    const std::string& longest = *std::max_element(terms.begin(), terms.end(),
+        [](const std::string& a, const std::string& b) { return a.size() < b.size(); });
+
+    auto matches = [&terms](const std::string& text) {
+      if (text.empty()) return false;
+      for (const auto& term : terms) {
+        if (text.find(term) == std::string::npos) return false;
+      }
+      return true;
+    };
+
+    std::vector<std::string> result;
+    if (longest.size() < 3) {
+      for (const auto& [pointer, id] : by_pointer_) {
+        if (matches(texts_[id])) result.push_back(pointer);
+      }
+      return result;
+    }
+
+    const std::vector<uint32_t>* candidates = nullptr;
+    for (size_t i = 0; i + 3 <= longest.size(); ++i) {
+      auto it = postings_.find(trigram_at(longest, i));
+      if (it == postings_.end()) return result;
+      if (!candidates || it->second.size() < candidates->size()) candidates = &it->second;
+    }
+    for (uint32_t id : *candidates) {
+      if (pointers_[id] && matches(texts_[id])) result.push_back(*pointers_[id]);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+}  // namespace ui
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ui {
+
+  // 编辑器配置项的搜索索引
+  // 以 JSON Pointer 字符串为条目，按有序表支持 O(log n) 的精确定位和子树删除，
+  // 按三元组（trigram）倒排表支持不区分大小写的子串搜索。编辑时只需增删受影响的子树。
+  class search_index {
+  public:
+    // 添加条目（已存在时忽略）
+    void insert(const std::string& pointer);
+
+    // 删除 pointer 的所有子孙条目（不含 pointer 本身）
+    void erase_children(const std::string& pointer);
+
+    void clear();
+
+    // 条目是否存在
+    bool contains(const std::string& pointer) const;
+
+    // 搜索：以空格分隔的每个词都需作为子串出现在路径中（不区分大小写），
+    // 返回匹配的 pointer，按字典序排列
+    std::vector<std::string> search(const std::string& query) const;
+
+    size_t size() const { return by_pointer_.size(); }
+
+  private:
+    void add_postings(uint32_t id);
+    void compact();
+
+    std::map<std::string, uint32_t> by_pointer_;  // pointer -> 条目 id
+    std::vector<std::string> texts_;              // id -> 小写路径
+    std::vector<const std::string*> pointers_;    // id -> by_pointer_ 中的键（已删除为 nullptr）
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings_;  // 三元组 -> 条目 id
+    size_t dead_ = 0;
+  };
+
+}  // namespace ui
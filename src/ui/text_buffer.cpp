@@ -0,0 +1,114 @@
+#include "text_buffer.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace ui {
+
+  namespace {
+    constexpr size_t min_gap = 4096;
+  }
+
+  void text_buffer::assign(std::string_view text) {
+    data_.assign(text.size() + min_gap, '\0');
+    std::memcpy(data_.data(), text.data(), text.size());
+    gap_begin_ = text.size();
+    gap_end_ = data_.size();
+
+    line_starts_.assign(1, 0);
+    for (size_t i = 0; i < text.size(); ++i) {
+      if (text[i] == '\n') line_starts_.push_back(i + 1);
+    }
+  }
+
+  size_t text_buffer::line_length(size_t line) const {
+    size_t end = line + 1 < line_starts_.size() ? line_starts_[line + 1] - 1 : size();
+    return end - line_starts_[line];
+  }
+
+  std::string text_buffer::line(size_t line) const {
+    size_t begin = line_starts_[line];
+    size_t length = line_length(line);
+    std::string out;
+    out.reserve(length);
+    // 行可能跨越空隙，分成空隙前后两段复制
+    size_t end = begin + length;
+    if (begin < gap_begin_) out.append(data_.data() + begin, std::min(end, gap_begin_) - begin);
+    if (end > gap_begin_) {
+      size_t from = std::max(begin, gap_begin_);
+      size_t gap = gap_end_ - gap_begin_;
+      out.append(data_.data() + from + gap, end - from);
+    }
+    return out;
+  }
+
+  size_t text_buffer::line_of(size_t pos) const {
+    auto it = std::upper_bound(line_starts_.begin(), line_starts_.end(), pos);
+    return static_cast<size_t>(it - line_starts_.begin()) - 1;
+  }
+
+  void text_buffer::move_gap(size_t pos) {
+    size_t gap = gap_end_ - gap_begin_;
+    if (pos < gap_begin_) {
+      std::memmove(data_.data() + pos + gap, data_.data() + pos, gap_begin_ - pos);
+    } else if (pos > gap_begin_) {
+      std::memmove(data_.data() + gap_begin_, data_.data() + gap_end_, pos - gap_begin_);
+    }
+    gap_begin_ = pos;
+    gap_end_ = pos + gap;
+  }
+
+  void text_buffer::reserve_gap(size_t count) {
+    size_t gap = gap_end_ - gap_begin_;
+    if (gap >= count) return;
+    // 空隙不足时整体扩容，空隙按当前大小的一半增长，均摊 O(1)
+    size_t grow = std::max({count - gap, min_gap, data_.size() / 2});
+    size_t tail = data_.size() - gap_end_;
+    data_.resize(data_.size() + grow);
+    std::memmove(data_.data() + data_.size() - tail, data_.data() + gap_end_, tail);
+    gap_end_ = data_.size() - tail;
+  }
+
+  void text_buffer::insert(size_t pos, std::string_view text) {
+    if (text.empty()) return;
+    pos = std::min(pos, size());
+    reserve_gap(text.size());
+    move_gap(pos);
+    std::memcpy(data_.data() + gap_begin_, text.data(), text.size());
+    gap_begin_ += text.size();
+
+    // 之后各行的起始位置后移，再插入新出现的行
+    size_t line = line_of(pos);
+    for (size_t i = line + 1; i < line_starts_.size(); ++i) line_starts_[i] += text.size();
+    std::vector<size_t> added;
+    for (size_t i = 0; i < text.size(); ++i) {
+      if (text[i] == '\n') added.push_back(pos + i + 1);
+    }
+    line_starts_.insert(line_starts_.begin() + line + 1, added.begin(), added.end());
+  }
+
+  void text_buffer::erase(size_t pos, size_t count) {
+    if (pos >= size()) return;
+    count = std::min(count, size() - pos);
+    if (count == 0) return;
+    move_gap(pos);
+    gap_end_ += count;
+
+    // 起始位置落在被删区间 (pos, pos + count] 内的行被合并，其后的行前移
+    auto first = std::upper_bound(line_starts_.begin(), line_starts_.end(), pos);
+    auto last = std::upper_bound(first, line_starts_.end(), pos + count);
+    for (auto it = last; it != line_starts_.end(); ++it) *it -= count;
+    line_starts_.erase(first, last);
+  }
+
+  void text_buffer::write_to(std::string& out) const {
+    out.assign(data_.data(), gap_begin_);
+    out.append(data_.data() + gap_end_, data_.size() - gap_end_);
+  }
+
+  std::string text_buffer::str() const {
+    std::string out;
+    write_to(out);
+    return out;
+  }
+
+}  // namespace ui
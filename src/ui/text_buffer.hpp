@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ui {
+
+  // 大文本的编辑缓冲（gap buffer）
+  // 文本存放在一块连续内存中，光标处留一段空隙：在光标附近连续输入、删除只移动空隙边界，
+  // 不搬动整段文本。另外维护每行的起始位置，按行号取行是 O(1)，渲染时只需取可见的几行。
+  // 位置均为逻辑字节偏移（不含空隙）。
+  class text_buffer {
+  public:
+    text_buffer() { assign(""); }
+    explicit text_buffer(std::string_view text) { assign(text); }
+
+    // 替换全部内容
+    void assign(std::string_view text);
+
+    size_t size() const { return data_.size() - (gap_end_ - gap_begin_); }
+    size_t line_count() const { return line_starts_.size(); }
+
+    // 行的起始位置和长度（不含换行符）
+    size_t line_start(size_t line) const { return line_starts_[line]; }
+    size_t line_length(size_t line) const;
+
+    // 取一行的内容（不含换行符）
+    std::string line(size_t line) const;
+
+    // 位置所在的行
+    size_t line_of(size_t pos) const;
+
+    // 第 pos 个字节，要求 pos < size()
+    char at(size_t pos) const { return pos < gap_begin_ ? data_[pos] : data_[pos + (gap_end_ - gap_begin_)]; }
+
+    void insert(size_t pos, std::string_view text);
+    void erase(size_t pos, size_t count);
+
+    // 将全部内容写入 out（复用 out 已有的容量，不经过中间字符串）
+    void write_to(std::string& out) const;
+
+    std::string str() const;
+
+  private:
+    void move_gap(size_t pos);
+    void reserve_gap(size_t count);
+
+    std::vector<char> data_;
+    size_t gap_begin_ = 0;
+    size_t gap_end_ = 0;
+    std::vector<size_t> line_starts_;  // 每行起始位置，第 0 行从 0 开始
+  };
+
+}  // namespace ui
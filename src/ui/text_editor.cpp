@@ -0,0 +1,243 @@
+#include "text_editor.hpp"
+#include "ui_utils.hpp"
+#include <ftxui/component/component_base.hpp>
+#include <ftxui/component/event.hpp>
+#include <ftxui/component/mouse.hpp>
+#include <ftxui/dom/elements.hpp>
+#include <algorithm>
+
+using namespace ftxui;
+
+namespace ui {
+
+  namespace {
+
+    bool is_continuation(char c) {
+      return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+    }
+
+    class text_editor_impl : public text_editor {
+    public:
+      text_editor_impl(text_buffer* buffer, int rows, int width, std::function<void()> on_change)
+          : buffer_(buffer), rows_(std::max(1, rows)), width_(std::max(10, width)), on_change_(std::move(on_change)) {}
+
+      void reset() override {
+        cursor_ = last_cursor_ = 0;
+        top_ = left_ = 0;
+        goal_col_ = npos;
+        follow_cursor_ = true;
+      }
+
+      Element OnRender() override {
+        clamp_cursor();
+        size_t cursor_line = buffer_->line_of(cursor_);
+        scroll_to(cursor_line);
+
+        const size_t lines = buffer_->line_count();
+        const int gutter = gutter_width();
+        const int text_width = std::max(1, width_ - gutter - 1);
+        const bool focused = Focused();
+
+        Elements rows;
+        for (size_t line = top_; line < lines && line < top_ + rows_; ++line) {
+          std::string content = buffer_->line(line);
+          // 水平滚动：只显示从 left_ 开始、最多 text_width 列的部分
+          size_t from = std::min(left_, content.size());
+          while (from > 0 && from < content.size() && is_continuation(content[from])) --from;
+          std::string visible = content.substr(from, static_cast<size_t>(text_width) * 4);
+
+          Element body;
+          if (focused && line == cursor_line) {
+            size_t col = cursor_ - buffer_->line_start(line);
+            size_t at = col >= from ? std::min(col - from, visible.size()) : 0;
+            size_t next = at;
+            if (next < visible.size()) {
+              ++next;
+              while (next < visible.size() && is_continuation(visible[next])) ++next;
+            }
+            std::string under = next > at ? visible.substr(at, next - at) : " ";
+            body = hbox({text(visible.substr(0, at)), text(under) | inverted, text(visible.substr(next))});
+          } else {
+            body = text(visible);
+          }
+          std::string number = std::to_string(line + 1);
+          rows.push_back(hbox({
+            text(std::string(gutter - number.size(), ' ') + number + " ") | dim,
+            body | size(WIDTH, LESS_THAN, text_width) | xflex,
+          }));
+        }
+
+        std::string status = "行 " + std::to_string(cursor_line + 1) + "/" + std::to_string(lines) +
+                             "  列 " + std::to_string(cursor_ - buffer_->line_start(cursor_line) + 1) +
+                             "  " + std::to_string(buffer_->size()) + " 字节";
+        return vbox({
+          vbox(std::move(rows)) | size(HEIGHT, EQUAL, rows_),
+          text(status) | dim,
+        }) | size(WIDTH, EQUAL, width_) | reflect(box_);
+      }
+
+      bool OnEvent(Event event) override {
+        if (event.is_mouse()) return on_mouse(event);
+        if (!Focused()) return false;
+        clamp_cursor();
+
+        size_t line = buffer_->line_of(cursor_);
+        if (event == Event::ArrowLeft) {
+          if (cursor_ == 0) return false;
+          cursor_ = prev_boundary(cursor_);
+          goal_col_ = npos;
+        } else if (event == Event::ArrowRight) {
+          if (cursor_ >= buffer_->size()) return false;
+          cursor_ = next_boundary(cursor_);
+          goal_col_ = npos;
+        } else if (event == Event::ArrowUp) {
+          if (line == 0) return false;
+          move_to_line(line - 1);
+        } else if (event == Event::ArrowDown) {
+          if (line + 1 >= buffer_->line_count()) return false;
+          move_to_line(line + 1);
+        } else if (event == Event::PageUp) {
+          move_to_line(line > static_cast<size_t>(rows_) ? line - rows_ : 0);
+        } else if (event == Event::PageDown) {
+          move_to_line(std::min(line + rows_, buffer_->line_count() - 1));
+        } else if (event == Event::Home) {
+          cursor_ = buffer_->line_start(line);
+          goal_col_ = npos;
+        } else if (event == Event::End) {
+          cursor_ = buffer_->line_start(line) + buffer_->line_length(line);
+          goal_col_ = npos;
+        } else if (event == Event::Return) {
+          insert("\n");
+        } else if (event == Event::Backspace) {
+          if (cursor_ == 0) return true;
+          size_t prev = prev_boundary(cursor_);
+          buffer_->erase(prev, cursor_ - prev);
+          cursor_ = prev;
+          changed();
+        } else if (event == Event::Delete) {
+          if (cursor_ >= buffer_->size()) return true;
+          buffer_->erase(cursor_, next_boundary(cursor_) - cursor_);
+          changed();
+        } else if (event.is_character()) {
+          insert(event.character());
+        } else {
+          return false;
+        }
+        return true;
+      }
+
+      bool Focusable() const override { return true; }
+
+    private:
+      static constexpr size_t npos = static_cast<size_t>(-1);
+
+      bool on_mouse(Event& event) {
+        if (!box_.Contain(event.mouse().x, event.mouse().y)) return false;
+        if (event.mouse().button == Mouse::WheelUp) {
+          top_ = top_ > 3 ? top_ - 3 : 0;
+          follow_cursor_ = false;
+          return true;
+        }
+        if (event.mouse().button == Mouse::WheelDown) {
+          size_t lines = buffer_->line_count();
+          top_ = std::min(top_ + 3, lines > static_cast<size_t>(rows_) ? lines - rows_ : 0);
+          follow_cursor_ = false;
+          return true;
+        }
+        if (event.mouse().button == Mouse::Left && event.mouse().motion == Mouse::Pressed) {
+          TakeFocus();
+          return true;
+        }
+        return false;
+      }
+
+      // 内容在编辑器之外被缩短（未调用 reset）时，光标退回到内容末尾
+      void clamp_cursor() {
+        if (cursor_ <= buffer_->size()) return;
+        cursor_ = buffer_->size();
+        goal_col_ = npos;
+      }
+
+      // 行号栏宽度：最大行号的位数加一个空格
+      int gutter_width() const {
+        return static_cast<int>(std::to_string(buffer_->line_count()).size()) + 1;
+      }
+
+      // pos 处是 UTF-8 后续字节；pos 到达内容末尾（如最后一行的行尾）时不读取 buffer
+      bool continuation_at(size_t pos) const {
+        return pos < buffer_->size() && is_continuation(buffer_->at(pos));
+      }
+
+      // 光标移动后让它回到可见区域；滚轮滚动时保持滚动位置，直到光标再次移动
+      void scroll_to(size_t cursor_line) {
+        if (cursor_ != last_cursor_) {
+          follow_cursor_ = true;
+          last_cursor_ = cursor_;
+        }
+        if (follow_cursor_) {
+          if (cursor_line < top_) top_ = cursor_line;
+          if (cursor_line >= top_ + rows_) top_ = cursor_line - rows_ + 1;
+
+          size_t col = cursor_ - buffer_->line_start(cursor_line);
+          // 与 OnRender 使用同一可见宽度，否则光标可能滚出可见区域
+          size_t text_width = static_cast<size_t>(std::max(1, width_ - gutter_width() - 1));
+          if (col < left_) left_ = col;
+          if (col >= left_ + text_width) left_ = col - text_width + 1;
+        }
+        top_ = std::min(top_, buffer_->line_count() - 1);
+      }
+
+      void move_to_line(size_t target) {
+        size_t line = buffer_->line_of(cursor_);
+        if (goal_col_ == npos) goal_col_ = cursor_ - buffer_->line_start(line);
+        size_t pos = buffer_->line_start(target) + std::min(goal_col_, buffer_->line_length(target));
+        while (pos > buffer_->line_start(target) && continuation_at(pos)) --pos;
+        cursor_ = pos;
+      }
+
+      size_t prev_boundary(size_t pos) const {
+        do {
+          --pos;
+        } while (pos > 0 && continuation_at(pos));
+        return pos;
+      }
+
+      size_t next_boundary(size_t pos) const {
+        do {
+          ++pos;
+        } while (continuation_at(pos));
+        return pos;
+      }
+
+      void insert(const std::string& s) {
+        buffer_->insert(cursor_, s);
+        cursor_ += s.size();
+        changed();
+      }
+
+      void changed() {
+        goal_col_ = npos;
+        if (on_change_) on_change_();
+      }
+
+      text_buffer* buffer_;
+      int rows_;
+      int width_;
+      std::function<void()> on_change_;
+      size_t cursor_ = 0;
+      size_t last_cursor_ = 0;
+      size_t goal_col_ = npos;  // 上下移动时希望保持的列
+      size_t top_ = 0;          // 第一可见行
+      size_t left_ = 0;         // 水平滚动的起始字节
+      bool follow_cursor_ = true;
+      Box box_;
+    };
+
+  }  // namespace
+
+  std::shared_ptr<text_editor> make_text_editor(text_buffer* buffer, int rows, int width,
+                                                std::function<void()> on_change) {
+    return std::make_shared<text_editor_impl>(buffer, rows, width, std::move(on_change));
+  }
+
+}  // namespace ui
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <ftxui/component/component_base.hpp>
+#include "text_buffer.hpp"
+
+namespace ui {
+
+  // 多行文本编辑器组件。编辑器之外整体替换了 text_buffer 的内容（如 assign）后须调用 reset()，
+  // 让光标和滚动位置回到开头，否则它们可能超出新内容的范围
+  class text_editor : public ftxui::ComponentBase {
+  public:
+    virtual void reset() = 0;
+  };
+
+  // 多行文本编辑器，编辑 text_buffer 中的内容
+  // 每帧只取出可见的 rows 行来渲染，超长的行按列水平滚动；
+  // 光标在首行按 ↑、在末行按 ↓ 时不处理事件，焦点可以移出编辑器。
+  // on_change 在内容被修改后调用。
+  std::shared_ptr<text_editor> make_text_editor(text_buffer* buffer, int rows, int width,
+                                                std::function<void()> on_change = {});
+
+}  // namespace ui
@@ -0,0 +1,143 @@
+#include "workspace_view.hpp"
+#include "ui_utils.hpp"
+#include "../config.h"
+#include <ftxui/component/component.hpp>
+#include <ftxui/component/screen_interactive.hpp>
+#include <ftxui/dom/elements.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+using namespace ftxui;
+
+namespace ui {
+
+    namespace {
+
+        // 按显示列宽右侧补空格（中文占两列）
+        std::string pad(const std::string& s, int width) {
+            int w = utf8_display_width(s);
+            return w >= width ? s : s + std::string(width - w, ' ');
+        }
+
+        const char* status_label(config::app_status::state status) {
+            switch (status) {
+                case config::app_status::state::valid: return "✔ 有效";
+                case config::app_status::state::invalid: return "✘ 校验失败";
+                case config::app_status::state::no_active: return "- 未激活";
+                case config::app_status::state::error: return "! 读取失败";
+            }
+            return "";
+        }
+
+        Color status_color(config::app_status::state status) {
+            switch (status) {
+                case config::app_status::state::valid: return Color::Green;
+                case config::app_status::state::invalid: return Color::Red;
+                case config::app_status::state::error: return Color::Yellow;
+                default: return Color::GrayLight;
+            }
+        }
+
+    }  // namespace
+
+    std::string run_workspace_ui() {
+        auto screen = ScreenInteractive::Fullscreen();
+        const std::string home = config::config_home();
+
+        std::vector<config::app_status> apps;
+        std::vector<std::string> labels;
+        int selected = 0;
+        bool scanning = false;
+        double scan_ms = 0;
+        std::string result;
+        std::thread scanner;
+
+        // 扫描在后台线程进行，完成后把结果投递回界面线程
+        auto rescan = [&] {
+            if (scanning) return;
+            scanning = true;
+            if (scanner.joinable()) scanner.join();
+            scanner = std::thread([&] {
+                auto start = std::chrono::steady_clock::now();
+                auto scanned = config::scan_workspace(home);
+                double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                screen.Post([&, scanned = std::move(scanned), elapsed]() mutable {
+                    apps = std::move(scanned);
+                    labels.clear();
+                    for (const auto& app : apps) {
+                        labels.push_back(pad(app.name, 24) + pad(std::to_string(app.config_count), 8) +
+                                         pad(app.active.empty() ? "-" : app.active, 28) + status_label(app.status));
+                    }
+                    if (selected >= static_cast<int>(apps.size())) selected = 0;
+                    scan_ms = elapsed;
+                    scanning = false;
+                });
+                screen.PostEvent(Event::Custom);
+            });
+        };
+
+        auto menu = Menu(&labels, &selected);
+        auto buttons = Container::Horizontal({
+            Button("打开", [&] {
+                if (selected >= 0 && selected < static_cast<int>(apps.size())) {
+                    result = apps[selected].name;
+                    screen.Exit();
+                }
+            }),
+            Button("重新扫描", [&] { rescan(); }),
+            Button("退出", [&] { screen.Exit(); }),
+        });
+        auto layout = Container::Vertical({ menu, buttons });
+
+        auto renderer = Renderer(layout, [&] {
+            Elements detail;
+            if (selected >= 0 && selected < static_cast<int>(apps.size())) {
+                const auto& app = apps[selected];
+                std::ostringstream took;
+                took << std::fixed << std::setprecision(1) << app.scan_ms << " ms";
+                detail.push_back(text(app.dir));
+                detail.push_back(hbox({ text("状态: "), text(status_label(app.status)) | color(status_color(app.status)),
+                                        text("  扫描耗时: " + took.str()) }));
+                if (!app.message.empty()) {
+                    detail.push_back(vbox(make_wrapped_text(app.message, get_terminal_width() - 4)) |
+                                     color(status_color(app.status)));
+                }
+            }
+
+            std::string summary;
+            if (scanning) {
+                summary = "扫描中...";
+            } else {
+                size_t problems = std::count_if(apps.begin(), apps.end(), [](const config::app_status& app) {
+                    return app.status == config::app_status::state::invalid ||
+                           app.status == config::app_status::state::error;
+                });
+                std::ostringstream oss;
+                oss << apps.size() << " 个应用，" << problems << " 个存在问题，耗时 "
+                    << std::fixed << std::setprecision(1) << scan_ms << " ms";
+                summary = oss.str();
+            }
+
+            return vbox({
+                text("工作区 - " + home) | bold | center,
+                separator(),
+                text(pad("应用", 24) + pad("配置数", 8) + pad("激活配置", 28) + "状态") | bold,
+                menu->Render() | vscroll_indicator | frame | flex,
+                separator(),
+                vbox(std::move(detail)) | size(HEIGHT, LESS_THAN, 10),
+                separator(),
+                buttons->Render() | center,
+                text(summary) | color(Color::GrayLight),
+            }) | border;
+        });
+
+        rescan();
+        screen.Loop(renderer);
+        if (scanner.joinable()) scanner.join();
+        return result;
+    }
+
+}  // namespace ui
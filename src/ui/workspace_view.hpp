@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+
+namespace ui {
+
+    // 工作区总览：并行扫描配置根目录下的所有应用，列出配置数、激活配置和校验状态。
+    // 返回用户选择打开的应用名，直接退出时返回空串
+    std::string run_workspace_ui();
+
+}  // namespace ui
@@ -1,46 +1,367 @@
 #include "fs.hpp"
+#include "task_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <functional>
 
 #ifdef _WIN32
 #include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+#ifdef __linux__
+#include <dirent.h>
+#include <sys/syscall.h>
 #endif
 
 namespace utils::filesystem {
 
-std::vector<std::string> list_json_files(const std::string& dir_path) {
-    std::vector<std::string> files;
+namespace {
 
-    try {
-        for (const auto& entry : fs::directory_iterator(dir_path)) {
-            if (entry.is_regular_file() && entry.path().extension() == ".json") {
-                files.push_back(entry.path().filename().string());
+    bool has_json_extension(const char* name, size_t length) {
+        return length > 5 && std::memcmp(name + length - 5, ".json", 5) == 0;
+    }
+
+    uint64_t fingerprint(uint64_t ino, uint64_t size, int64_t mtime, int64_t ctime) {
+        uint64_t h = 1469598103934665603ULL;
+        for (uint64_t v : {ino, size, static_cast<uint64_t>(mtime), static_cast<uint64_t>(ctime)}) {
+            h ^= v;
+            h *= 1099511628211ULL;
+            h ^= h >> 29;
+        }
+        return h;
+    }
+
+#ifdef __linux__
+    // 读取目录中所有 *.json 的候选项；d_type 为 DT_UNKNOWN 或符号链接时需要 stat 才能确定类型
+    struct candidate {
+        std::string name;
+        bool known_regular;
+    };
+
+    std::vector<candidate> read_candidates(int dir_fd, const std::string& dir_path) {
+        struct linux_dirent64 {
+            uint64_t d_ino;
+            int64_t d_off;
+            unsigned short d_reclen;
+            unsigned char d_type;
+            char d_name[1];
+        };
+
+        std::vector<candidate> found;
+        std::vector<char> buffer(256 * 1024);  // 每次系统调用读取尽量多的目录项，减少网络文件系统的往返
+        for (;;) {
+            long n = ::syscall(SYS_getdents64, dir_fd, buffer.data(), buffer.size());
+            if (n < 0) {
+                throw std::runtime_error("Error listing JSON files: " + dir_path + ": " + std::strerror(errno));
+            }
+            if (n == 0) break;
+            for (long offset = 0; offset < n;) {
+                auto* entry = reinterpret_cast<linux_dirent64*>(buffer.data() + offset);
+                offset += entry->d_reclen;
+                size_t length = std::strlen(entry->d_name);
+                if (!has_json_extension(entry->d_name, length)) continue;
+                if (entry->d_type == DT_REG) {
+                    found.push_back({std::string(entry->d_name, length), true});
+                } else if (entry->d_type == DT_LNK || entry->d_type == DT_UNKNOWN) {
+                    found.push_back({std::string(entry->d_name, length), false});
+                }
             }
         }
-    } catch (const std::exception& e) {
-        throw std::runtime_error("Error listing JSON files: " + std::string(e.what()));
+        return found;
+    }
+
+    // 取元数据（跟随符号链接），失败或不是普通文件时返回 false
+    bool stat_entry(int dir_fd, const std::string& name, dir_entry& out) {
+#ifdef STATX_BASIC_STATS
+        struct statx st;
+        if (::statx(dir_fd, name.c_str(), AT_STATX_DONT_SYNC, STATX_TYPE | STATX_INO | STATX_SIZE | STATX_MTIME | STATX_CTIME,
+                    &st) != 0) {
+            return false;
+        }
+        if (!S_ISREG(st.stx_mode)) return false;
+        int64_t mtime = st.stx_mtime.tv_sec * 1000000000LL + st.stx_mtime.tv_nsec;
+        int64_t ctime = st.stx_ctime.tv_sec * 1000000000LL + st.stx_ctime.tv_nsec;
+        out.size = st.stx_size;
+        out.mtime = mtime;
+        out.hint = fingerprint(st.stx_ino, st.stx_size, mtime, ctime);
+#else
+        struct stat st;
+        if (::fstatat(dir_fd, name.c_str(), &st, 0) != 0) return false;
+        if (!S_ISREG(st.st_mode)) return false;
+        int64_t mtime = st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+        int64_t ctime = st.st_ctim.tv_sec * 1000000000LL + st.st_ctim.tv_nsec;
+        out.size = static_cast<uint64_t>(st.st_size);
+        out.mtime = mtime;
+        out.hint = fingerprint(st.st_ino, out.size, mtime, ctime);
+#endif
+        return true;
     }
 
+    std::vector<dir_entry> scan(const std::string& dir_path, bool with_stat) {
+        int dir_fd = ::open(dir_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dir_fd < 0) {
+            throw std::runtime_error("Error listing JSON files: " + dir_path + ": " + std::strerror(errno));
+        }
+        std::vector<candidate> candidates;
+        try {
+            candidates = read_candidates(dir_fd, dir_path);
+        } catch (...) {
+            ::close(dir_fd);
+            throw;
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const candidate& a, const candidate& b) { return a.name < b.name; });
+
+        std::vector<dir_entry> entries(candidates.size());
+        std::vector<char> keep(candidates.size(), 0);
+        std::vector<size_t> need_stat;  // 需要 statx 的候选项下标
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            entries[i].name = std::move(candidates[i].name);
+            if (with_stat || !candidates[i].known_regular) {
+                need_stat.push_back(i);
+            } else {
+                keep[i] = 1;
+            }
+        }
+
+        // 只有元数据请求交给线程池：它们彼此独立，网络文件系统上并行发出可以掩盖往返延迟；
+        // 只列文件名且 d_type 已确定类型时（list_json_files 的常见情况）没有要 stat 的项，不经过线程池
+        if (!need_stat.empty()) {
+            auto stat_range = [&](size_t begin, size_t end) {
+                for (size_t k = begin; k < end; ++k) {
+                    size_t i = need_stat[k];
+                    keep[i] = stat_entry(dir_fd, entries[i].name, entries[i]);
+                }
+            };
+            constexpr size_t chunk = 256;
+            std::vector<std::function<void()>> tasks;
+            for (size_t begin = 0; begin < need_stat.size(); begin += chunk) {
+                size_t end = std::min(need_stat.size(), begin + chunk);
+                tasks.push_back([&stat_range, begin, end] { stat_range(begin, end); });
+            }
+            utils::run_tasks(tasks);
+        }
+        ::close(dir_fd);
+
+        std::vector<dir_entry> result;
+        result.reserve(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (keep[i]) result.push_back(std::move(entries[i]));
+        }
+        return result;
+    }
+#else
+    std::vector<dir_entry> scan(const std::string& dir_path, bool with_stat) {
+        std::vector<dir_entry> result;
+        try {
+            for (const auto& entry : fs::directory_iterator(dir_path)) {
+                std::string name = entry.path().filename().string();
+                if (!has_json_extension(name.c_str(), name.size()) || !entry.is_regular_file()) continue;
+                dir_entry item;
+                item.name = std::move(name);
+                if (with_stat) {
+                    // Windows 上 directory_iterator 已缓存这些属性，不会额外访问文件
+                    item.size = entry.file_size();
+                    item.mtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     entry.last_write_time().time_since_epoch()).count();
+                    item.hint = fingerprint(0, item.size, item.mtime, 0);
+                }
+                result.push_back(std::move(item));
+            }
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Error listing JSON files: " + std::string(e.what()));
+        }
+        std::sort(result.begin(), result.end(), [](const dir_entry& a, const dir_entry& b) { return a.name < b.name; });
+        return result;
+    }
+#endif
+
+}  // namespace
+
+std::vector<dir_entry> scan_json_files(const std::string& dir_path) {
+    return scan(dir_path, true);
+}
+
+std::vector<std::string> list_json_files(const std::string& dir_path) {
+    std::vector<std::string> files;
+    for (auto& entry : scan(dir_path, false)) files.push_back(std::move(entry.name));
     return files;
 }
 
+uint64_t files_stamp(const std::string& dir, const std::vector<std::string>& relative_paths) {
+    uint64_t h = 1469598103934665603ULL;
+    for (const auto& rel : relative_paths) {
+        std::error_code ec;
+        fs::path path = fs::path(dir) / rel;
+        auto mtime = static_cast<int64_t>(fs::last_write_time(path, ec).time_since_epoch().count());
+        if (ec) mtime = -1;
+        auto size = static_cast<uint64_t>(fs::file_size(path, ec));
+        if (ec) size = 0;
+        h = fingerprint(h, std::hash<std::string>{}(rel), mtime, static_cast<int64_t>(size));
+    }
+    return h;
+}
+
 bool create_symlink(const std::string& target, const std::string& link_path) {
+    std::string staged = stage_symlink(target, link_path);
+    if (staged.empty()) return false;
+    if (!commit_symlink(staged, link_path)) return false;
+    sync_dir(fs::path(link_path).parent_path().string());
+    return true;
+}
+
+std::string stage_symlink(const std::string& target, const std::string& link_path) {
+    static std::atomic<unsigned> counter{0};
+#ifdef _WIN32
+    unsigned long pid = GetCurrentProcessId();
+#else
+    unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+    std::string staged = link_path + ".tmp-" + std::to_string(pid) + "-" + std::to_string(counter++);
     try {
-        fs::remove(link_path);  // 统一先删除旧链接（Windows + Linux）
+        fs::remove(staged);  // 上次中断残留的同名临时链接
 
 #ifdef _WIN32
+        // 目标可能尚未就位（如先暂存、稍后才改名到位的合并配置），此时按文件链接创建
         DWORD attr = GetFileAttributesA(target.c_str());
-        if (attr == INVALID_FILE_ATTRIBUTES) return false;
-
-        bool is_dir = attr & FILE_ATTRIBUTE_DIRECTORY;
-        return CreateSymbolicLinkA(link_path.c_str(), target.c_str(),
-                                   is_dir ? SYMBOLIC_LINK_FLAG_DIRECTORY : 0);
+        bool is_dir = attr != INVALID_FILE_ATTRIBUTES && (attr & FILE_ATTRIBUTE_DIRECTORY);
+        if (!CreateSymbolicLinkA(staged.c_str(), target.c_str(), is_dir ? SYMBOLIC_LINK_FLAG_DIRECTORY : 0)) {
+            return "";
+        }
 #else
-        fs::create_symlink(target, link_path);
-        return true;
+        fs::create_symlink(target, staged);
 #endif
+        return staged;
     } catch (const std::exception& e) {
-        return false;
+        return "";
+    }
+}
+
+bool commit_symlink(const std::string& staged_path, const std::string& link_path) {
+#ifdef _WIN32
+    bool ok = MoveFileExA(staged_path.c_str(), link_path.c_str(), MOVEFILE_REPLACE_EXISTING);
+#else
+    // rename(2) 原子地替换目标目录项
+    bool ok = ::rename(staged_path.c_str(), link_path.c_str()) == 0;
+#endif
+    if (!ok) {
+        std::error_code ec;
+        fs::remove(staged_path, ec);
+    }
+    return ok;
+}
+
+// 沿符号链接找到最终的目标路径（目标可以尚不存在）；链接层数过多时放弃，按原路径处理
+static std::string resolve_symlinks(const std::string& path) {
+    fs::path current(path);
+    for (int depth = 0; depth < 40; ++depth) {
+        std::error_code ec;
+        if (!fs::is_symlink(fs::symlink_status(current, ec))) return current.string();
+        fs::path target = fs::read_symlink(current, ec);
+        if (ec) break;
+        current = target.is_absolute() ? target : current.parent_path() / target;
+    }
+    return path;
+}
+
+std::string stage_file(const std::string& path, const std::string& content) {
+    static std::atomic<unsigned> counter{0};
+#ifdef _WIN32
+    unsigned long pid = GetCurrentProcessId();
+#else
+    unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+    // path 是符号链接时替换它指向的文件，链接本身保持不变；临时文件放在目标所在目录，保证 rename 不跨文件系统
+    const std::string target = resolve_symlinks(path);
+    std::string staged = target + ".tmp-" + std::to_string(pid) + "-" + std::to_string(counter++);
+#ifdef _WIN32
+    std::ofstream ofs(staged, std::ios::binary);
+    if (!ofs.is_open()) throw std::runtime_error("Cannot open file for writing: " + staged);
+    ofs << content;
+    ofs.flush();
+    if (!ofs) {
+        ofs.close();
+        std::error_code ec;
+        fs::remove(staged, ec);
+        throw std::runtime_error("Failed to write file: " + staged);
+    }
+#else
+    // 已有文件：临时文件先以 0600 创建，再改成原文件的权限和属主，0600 的配置不会在替换后变得全局可读；
+    // 新文件按 0644 创建（受 umask 限制）。属主只有特权进程能改，失败时保留当前用户
+    struct stat existing;
+    const bool replacing = ::stat(target.c_str(), &existing) == 0 && S_ISREG(existing.st_mode);
+    int fd = ::open(staged.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, replacing ? 0600 : 0644);
+    if (fd < 0) throw std::runtime_error("Cannot open file for writing: " + staged + ": " + std::strerror(errno));
+    if (replacing) {
+        if (::fchown(fd, existing.st_uid, existing.st_gid) != 0) {
+            // 非特权进程：至少保留属组（调用者属于该组时可以设置）
+            (void)::fchown(fd, static_cast<uid_t>(-1), existing.st_gid);
+        }
+        // fchown 会清除 setuid/setgid 位，所以权限在属主之后设置
+        if (::fchmod(fd, existing.st_mode & 07777) != 0) {
+            std::string reason = std::strerror(errno);
+            ::close(fd);
+            ::unlink(staged.c_str());
+            throw std::runtime_error("Failed to write file: " + path + ": " + reason);
+        }
+    }
+    size_t written = 0;
+    while (written < content.size()) {
+        ssize_t n = ::write(fd, content.data() + written, content.size() - written);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        written += static_cast<size_t>(n);
+    }
+    // 内容先落盘再改名，断电后不会出现指向空文件的新目录项
+    bool ok = written == content.size() && ::fsync(fd) == 0;
+    std::string reason = ok ? "" : std::strerror(errno);
+    ::close(fd);
+    if (!ok) {
+        ::unlink(staged.c_str());
+        throw std::runtime_error("Failed to write file: " + path + ": " + reason);
     }
+#endif
+    return staged;
+}
+
+void commit_file(const std::string& staged_path, const std::string& path) {
+    const std::string target = resolve_symlinks(path);
+#ifdef _WIN32
+    if (!MoveFileExA(staged_path.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        std::error_code ec;
+        fs::remove(staged_path, ec);
+        throw std::runtime_error("Failed to replace file: " + path);
+    }
+#else
+    if (::rename(staged_path.c_str(), target.c_str()) != 0) {
+        std::string reason = std::strerror(errno);
+        ::unlink(staged_path.c_str());
+        throw std::runtime_error("Failed to write file: " + path + ": " + reason);
+    }
+#endif
+}
+
+void write_file_atomic(const std::string& path, const std::string& content) {
+    commit_file(stage_file(path, content), path);
+}
+
+void sync_dir(const std::string& dir_path) {
+#ifndef _WIN32
+    int fd = ::open(dir_path.empty() ? "." : dir_path.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) return;
+    ::fsync(fd);
+    ::close(fd);
+#else
+    (void)dir_path;
+#endif
 }
 
 std::string read_symlink(const std::string& link_path) {
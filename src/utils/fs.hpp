@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <filesystem>
@@ -8,12 +9,50 @@ namespace fs = std::filesystem;
 
 namespace utils::filesystem {
 
-    // 列出目录下所有 *.json 文件（不含子目录）
+    // 目录扫描得到的一个文件
+    struct dir_entry {
+        std::string name;
+        uint64_t size = 0;
+        int64_t mtime = 0;  // 修改时间（纳秒），只用于比较是否变化
+        uint64_t hint = 0;  // 由 inode、大小、修改和状态变更时间算出的指纹；不变时可认为内容未变，无需重读
+    };
+
+    // 列出目录下所有 *.json 普通文件（不含子目录），按文件名排序，附带大小、修改时间和变化指纹。
+    // Linux 上以大块 getdents64 读取目录项，按 d_type 跳过非普通文件，只对 *.json 取元数据
+    // （statx 不强制与服务器同步，多线程并行）；其他平台使用 directory_iterator。
+    std::vector<dir_entry> scan_json_files(const std::string& dir_path);
+
+    // 列出目录下所有 *.json 文件（不含子目录），按文件名排序；只需文件名时不取元数据
     std::vector<std::string> list_json_files(const std::string& dir_path);
 
-    // 创建符号链接（active → target）
+    // dir 下一组文件（相对路径）的修改时间和大小合成的指纹，不存在的文件也参与计算；
+    // 用于判断一组文件自上次以来是否可能被修改，不读取内容
+    uint64_t files_stamp(const std::string& dir, const std::vector<std::string>& relative_paths);
+
+    // 创建符号链接（active → target）。已有链接被原子替换：新链接先以临时名创建，再 rename 覆盖，
+    // 并同步所在目录，读者在任何时刻都能看到旧链接或新链接，不会遇到链接不存在
     bool create_symlink(const std::string& target, const std::string& link_path);
 
+    // 在 link_path 同目录下以临时名创建指向 target 的符号链接，返回临时路径（失败返回空字符串）；target 可以尚不存在
+    std::string stage_symlink(const std::string& target, const std::string& link_path);
+
+    // 将 stage_symlink 创建的临时链接原子地改名为 link_path（不同步目录）
+    bool commit_symlink(const std::string& staged_path, const std::string& link_path);
+
+    // 原子地写入文件：先写同目录下的临时文件并落盘，再 rename 覆盖 path（不同步目录，由调用方批量 sync_dir）。
+    // 任何时刻读者看到的都是完整的旧内容或新内容；失败时抛异常，原文件不变。
+    // 替换已有文件时保留其权限和属主；path 是符号链接时写入链接指向的文件，链接本身不变
+    void write_file_atomic(const std::string& path, const std::string& content);
+
+    // write_file_atomic 的两个阶段，供需要先准备好一批文件、再集中切换的调用方使用：
+    // stage_file 把内容写到 path（或其指向的文件）同目录下的临时文件并落盘，返回临时路径，失败时抛异常；
+    // commit_file 把临时文件原子地改名为 path，失败时删除临时文件并抛异常
+    std::string stage_file(const std::string& path, const std::string& content);
+    void commit_file(const std::string& staged_path, const std::string& path);
+
+    // 将目录项的修改（创建、改名）落盘；Windows 上无需也无法对目录 fsync，直接返回
+    void sync_dir(const std::string& dir_path);
+
     // 读取符号链接指向的目标路径（返回空字符串表示失败或非符号链接）
     std::string read_symlink(const std::string& link_path);
 
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+
+namespace utils {
+
+    // data 的 SHA-256 摘要，返回 64 位小写十六进制字符串
+    // 用于按内容寻址的存储：内容不同而摘要相同在实际中不会发生，命中时无需再比较内容
+    std::string sha256_hex(const std::string& data);
+
+}  // namespace utils
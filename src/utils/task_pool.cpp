@@ -0,0 +1,170 @@
+#include "task_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace utils {
+
+    namespace {
+
+        // 任务数少于此值时不值得分发，由调用线程直接执行
+        constexpr size_t min_parallel_tasks = 4;
+
+        // 当前线程是否为共享线程池的工作线程；工作线程中再调用 run_tasks 时直接执行，避免线程数层层相乘
+        thread_local bool in_pool_worker = false;
+
+        struct work_queue {
+            std::mutex mutex;
+            std::deque<std::function<void()>*> tasks;
+
+            // 所有者从尾部取：最近放入的任务数据更可能还在缓存中
+            std::function<void()>* pop() {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (tasks.empty()) return nullptr;
+                auto task = tasks.back();
+                tasks.pop_back();
+                return task;
+            }
+
+            // 窃取者从头部取，与所有者的竞争最小
+            std::function<void()>* steal() {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (tasks.empty()) return nullptr;
+                auto task = tasks.front();
+                tasks.pop_front();
+                return task;
+            }
+        };
+
+        // 一次 run_tasks 调用的状态，位于调用线程的栈上
+        struct batch {
+            std::vector<std::unique_ptr<work_queue>> queues;
+            // 任务不会在执行中产生新任务，所有队列都空了就可以退出
+            std::atomic<size_t> remaining{0};
+            std::mutex error_mutex;
+            std::exception_ptr first_error;
+            size_t helpers_running = 0;  // 已被工作线程取走、尚未结束的协助者，受 pool 的锁保护
+
+            void work(unsigned self) {
+                const auto count = static_cast<unsigned>(queues.size());
+                while (remaining.load(std::memory_order_acquire) > 0) {
+                    std::function<void()>* task = queues[self]->pop();
+                    for (unsigned i = 1; !task && i < count; ++i) task = queues[(self + i) % count]->steal();
+                    if (!task) return;
+                    try {
+                        (*task)();
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(error_mutex);
+                        if (!first_error) first_error = std::current_exception();
+                    }
+                    remaining.fetch_sub(1, std::memory_order_release);
+                }
+            }
+        };
+
+        // 进程内共享的常驻线程池。工作线程只负责“协助”某个批次：从批次的队列中取任务直到取空
+        class shared_pool {
+        public:
+            static shared_pool& instance() {
+                static shared_pool pool;
+                return pool;
+            }
+
+            unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+            void run(batch& b) {
+                const auto helpers = static_cast<unsigned>(b.queues.size()) - 1;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    for (unsigned i = 1; i <= helpers; ++i) pending_.push_back({&b, i});
+                }
+                if (helpers == 1) {
+                    ready_.notify_one();
+                } else {
+                    ready_.notify_all();
+                }
+
+                b.work(0);
+
+                // 调用线程做完时，还没被取走的协助请求直接撤回；已开始的协助者可能仍在访问 b，等它们结束
+                std::unique_lock<std::mutex> lock(mutex_);
+                pending_.erase(std::remove_if(pending_.begin(), pending_.end(),
+                                              [&b](const helper& h) { return h.owner == &b; }),
+                               pending_.end());
+                done_.wait(lock, [&b] { return b.helpers_running == 0; });
+            }
+
+        private:
+            struct helper {
+                batch* owner;
+                unsigned self;
+            };
+
+            shared_pool() {
+                const unsigned count = std::max(1u, std::thread::hardware_concurrency()) - 1;
+                for (unsigned i = 0; i < count; ++i) workers_.emplace_back([this] { worker_loop(); });
+            }
+
+            ~shared_pool() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stopping_ = true;
+                }
+                ready_.notify_all();
+                for (auto& t : workers_) t.join();
+            }
+
+            void worker_loop() {
+                in_pool_worker = true;
+                std::unique_lock<std::mutex> lock(mutex_);
+                while (true) {
+                    ready_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+                    if (stopping_) return;
+                    helper h = pending_.front();
+                    pending_.pop_front();
+                    ++h.owner->helpers_running;
+                    lock.unlock();
+                    h.owner->work(h.self);
+                    lock.lock();
+                    if (--h.owner->helpers_running == 0) done_.notify_all();
+                }
+            }
+
+            std::mutex mutex_;
+            std::condition_variable ready_;
+            std::condition_variable done_;
+            std::deque<helper> pending_;
+            bool stopping_ = false;
+            std::vector<std::thread> workers_;
+        };
+
+    }  // namespace
+
+    void run_tasks(std::vector<std::function<void()>>& tasks, unsigned threads) {
+        if (tasks.empty()) return;
+        shared_pool* pool = nullptr;
+        if (!in_pool_worker && tasks.size() >= min_parallel_tasks) {
+            pool = &shared_pool::instance();
+            if (threads == 0) threads = pool->size() + 1;
+            threads = std::min({threads, pool->size() + 1, static_cast<unsigned>(tasks.size())});
+        }
+        if (!pool || threads <= 1) {
+            for (auto& task : tasks) task();
+            return;
+        }
+
+        batch b;
+        for (unsigned i = 0; i < threads; ++i) b.queues.push_back(std::make_unique<work_queue>());
+        for (size_t i = 0; i < tasks.size(); ++i) b.queues[i % threads]->tasks.push_back(&tasks[i]);
+        b.remaining.store(tasks.size(), std::memory_order_relaxed);
+
+        pool->run(b);
+        if (b.first_error) std::rethrow_exception(b.first_error);
+    }
+
+}  // namespace utils
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+namespace utils {
+
+    // 在进程内共享的常驻工作窃取线程池上执行一批互相独立的任务（线程数最多为 threads，0 表示按 CPU 数）
+    // 任务按轮转分到各线程的双端队列：线程从自己队列的尾部取任务，队列空了再从其他线程队列的头部窃取，
+    // 耗时不均的任务（如大小差异很大的子树）也能让所有线程一直有活干。调用线程也参与执行，返回时全部任务已完成。
+    // 任务很少，或调用方本身就在线程池的工作线程中（嵌套调用）时，直接在调用线程上依次执行。
+    // 任务内抛出的第一个异常在所有任务结束后重新抛出。
+    void run_tasks(std::vector<std::function<void()>>& tasks, unsigned threads = 0);
+
+}  // namespace utils
@@ -0,0 +1,105 @@
+#include "trace.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+namespace utils::trace {
+
+    namespace {
+
+        // 事件逐条追加到文件（JSON Array Format），程序退出时补上结尾的 ]。
+        // 即使进程异常退出，已写入的事件仍可被 Chrome 读取。
+        class trace_writer {
+        public:
+            trace_writer() {
+                const char* path = std::getenv("CONFIGMANAGER_TRACE");
+                if (!path || path[0] == '\0') return;
+                file_ = std::fopen(path, "w");
+                if (file_) std::fputs("[\n", file_);
+            }
+
+            ~trace_writer() {
+                if (!file_) return;
+                std::fputs("\n]\n", file_);
+                std::fclose(file_);
+            }
+
+            bool is_open() const { return file_ != nullptr; }
+
+            void write(const std::string& line) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!first_) std::fputs(",\n", file_);
+                first_ = false;
+                std::fputs(line.c_str(), file_);
+            }
+
+            clock::time_point origin() const { return origin_; }
+
+        private:
+            std::FILE* file_ = nullptr;
+            std::mutex mutex_;
+            bool first_ = true;
+            clock::time_point origin_ = clock::now();
+        };
+
+        trace_writer& writer() {
+            static trace_writer instance;
+            return instance;
+        }
+
+        // 线程编号：按首次写入事件的顺序分配，比 std::thread::id 更易读
+        int thread_number() {
+            static std::atomic<int> next{1};
+            thread_local int number = next++;
+            return number;
+        }
+
+        void append_escaped(std::string& out, const char* s) {
+            for (; *s; ++s) {
+                char c = *s;
+                if (c == '"' || c == '\\') {
+                    out += '\\';
+                    out += c;
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out += buf;
+                } else {
+                    out += c;
+                }
+            }
+        }
+
+    }  // namespace
+
+    namespace detail {
+
+        const bool enabled = writer().is_open();
+
+        void emit(const char* name, const char* category, clock::time_point start, clock::time_point end,
+                  const std::string& arg) {
+            using us = std::chrono::duration<double, std::micro>;
+            auto& w = writer();
+            char nums[96];
+            std::snprintf(nums, sizeof(nums), "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d",
+                          us(start - w.origin()).count(), us(end - start).count(), thread_number());
+
+            std::string line = "{\"name\":\"";
+            append_escaped(line, name);
+            line += "\",\"cat\":\"";
+            append_escaped(line, category);
+            line += nums;
+            if (!arg.empty()) {
+                line += ",\"args\":{\"detail\":\"";
+                append_escaped(line, arg.c_str());
+                line += "\"}";
+            }
+            line += "}";
+            w.write(line);
+        }
+
+    }  // namespace detail
+
+}  // namespace utils::trace
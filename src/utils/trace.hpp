@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+namespace utils::trace {
+
+    // 作用域追踪，输出 Chrome trace-event JSON（chrome://tracing 或 Perfetto 可直接打开）
+    // 设置环境变量 CONFIGMANAGER_TRACE=<文件> 启用；未设置时每个 span 只有一次布尔判断。
+
+    using clock = std::chrono::steady_clock;
+
+    namespace detail {
+        extern const bool enabled;
+        void emit(const char* name, const char* category, clock::time_point start, clock::time_point end,
+                  const std::string& arg);
+    }
+
+    inline bool enabled() { return detail::enabled; }
+
+    // 记录一个已结束的区间（用于无法用作用域表示的区间，如跨越多个函数的渲染过程）
+    inline void complete(const char* name, const char* category, clock::time_point start,
+                         const std::string& arg = {}) {
+        if (detail::enabled) detail::emit(name, category, start, clock::now(), arg);
+    }
+
+    // 从构造到析构的区间
+    class span {
+    public:
+        explicit span(const char* name, const char* category = "config") : name_(name), category_(category) {
+            if (detail::enabled) start_ = clock::now();
+        }
+
+        // arg 显示在事件详情中（如文件路径）；未启用时不复制
+        span(const char* name, const char* category, const std::string& arg) : span(name, category) {
+            if (detail::enabled) arg_ = arg;
+        }
+
+        ~span() {
+            if (detail::enabled) detail::emit(name_, category_, start_, clock::now(), arg_);
+        }
+
+        span(const span&) = delete;
+        span& operator=(const span&) = delete;
+
+    private:
+        const char* name_;
+        const char* category_;
+        clock::time_point start_;
+        std::string arg_;
+    };
+
+}  // namespace utils::trace
+
+#define CONFIGMANAGER_TRACE_CONCAT_(a, b) a##b
+#define CONFIGMANAGER_TRACE_CONCAT(a, b) CONFIGMANAGER_TRACE_CONCAT_(a, b)
+
+// TRACE_SCOPE("name") / TRACE_SCOPE("name", "category") / TRACE_SCOPE("name", "category", arg)
+#define TRACE_SCOPE(...) ::utils::trace::span CONFIGMANAGER_TRACE_CONCAT(trace_span_, __LINE__)(__VA_ARGS__)
@@ -0,0 +1,127 @@
+// ConfigManager_tests：核心路径的一致性检查，由 ctest 运行
+//
+//   ConfigManager_tests
+//
+// 每项不一致输出一行到标准错误；有任何不一致时返回非零。
+
+#include "../src/config.h"
+#include <nlohmann/json-schema.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    // 编译后的校验程序与校验库对同时含包含/不包含边界的 schema 给出的结论（是否通过）是否一致，返回不一致的数量
+    int bounds_parity_checks() {
+        static const char* const schemas[] = {
+            R"({"type":"number","exclusiveMinimum":0,"minimum":10})",
+            R"({"type":"number","minimum":10,"exclusiveMinimum":0})",
+            R"({"type":"number","minimum":0,"exclusiveMinimum":10})",
+            R"({"type":"number","exclusiveMaximum":100,"maximum":10})",
+            R"({"type":"number","maximum":100,"exclusiveMaximum":10})",
+        };
+        static const double instances[] = {-1, 0, 5, 10, 11, 100, 101};
+
+        int failures = 0;
+        for (const char* text : schemas) {
+            config::json schema = config::json::parse(text);
+            config::schema_program program(schema, [](const std::string& rel) -> const config::json& {
+                throw std::invalid_argument("Unexpected schema reference: " + rel);
+            });
+            nlohmann::json_schema::json_validator validator;
+            validator.set_root_schema(nlohmann::json::parse(text));
+            for (double value : instances) {
+                std::vector<config::validation_error> errors;
+                program.run(config::json(value), errors);
+                nlohmann::json_schema::basic_error_handler handler;
+                validator.validate(nlohmann::json(value), handler);
+                const bool program_valid = errors.empty();
+                const bool library_valid = !handler;
+                if (program_valid != library_valid) {
+                    std::cerr << "bounds parity mismatch: " << text << " instance " << value << ": program "
+                              << (program_valid ? "valid" : "invalid") << ", library "
+                              << (library_valid ? "valid" : "invalid") << std::endl;
+                    ++failures;
+                }
+            }
+        }
+        return failures;
+    }
+
+    // 分层配置逐个修改某一层的单个顶层键后，增量刷新（load_merged_config）与完整合并（merge_layers）的结果
+    // 是否完全一致（含键序），返回不一致的数量
+    int layered_refresh_checks(const fs::path& dir) {
+        struct edit {
+            const char* layer;
+            const char* content;
+        };
+        static const edit edits[] = {
+            {"overlay.json", R"({"b": {"y": 3}, "a": null})"},
+            {"layered.json", R"({"$base": "base.json", "$overlays": ["overlay.json"], "c": 3, "z": 1})"},
+            {"base.json", R"({"a": 1, "b": {"x": 1, "y": 2}, "c": 0, "n": [1, 2]})"},
+            {"overlay.json", R"({"b": {"y": 3}, "a": 7})"},
+            {"base.json", R"({"a": 1, "b": {"x": 1, "y": 2}, "c": 0})"},
+            {"overlay.json", R"({"b": null, "a": 7, "m": {"k": true}})"},
+            {"layered.json", R"({"$base": "base.json", "$overlays": ["overlay.json"], "z": 1})"},
+            {"base.json", R"({"q": 0, "a": 1, "b": {"x": 1, "y": 2}, "c": 0})"},
+        };
+        auto write = [&dir](const char* name, const char* content, int step) {
+            fs::path path = dir / name;
+            std::ofstream(path) << content;
+            // 修改时间逐步推后，避免同一时间片内的两次写入被当作未变化
+            fs::last_write_time(path, fs::file_time_type::clock::now() + std::chrono::seconds(step));
+        };
+
+        write("base.json", R"({"a": 1, "b": {"x": 1, "y": 2}, "c": 0})", 0);
+        write("overlay.json", R"({"b": {"y": 3}})", 0);
+        write("layered.json", R"({"$base": "base.json", "$overlays": ["overlay.json"], "c": 3})", 0);
+        std::string path = (dir / "layered.json").string();
+        config::load_merged_config(path);
+
+        int failures = 0;
+        int step = 1;
+        for (const auto& e : edits) {
+            write(e.layer, e.content, step++);
+            std::string refreshed = config::load_merged_config(path).dump();
+            std::string full = config::merge_layers(path, config::load_config(path), [](const std::string& layer) {
+                return config::load_config(layer);
+            }).dump();
+            if (refreshed != full) {
+                std::cerr << "layered refresh mismatch after editing " << e.layer << ": " << refreshed << " vs "
+                          << full << std::endl;
+                ++failures;
+            }
+        }
+        return failures;
+    }
+
+}  // namespace
+
+int main() {
+    try {
+        // 临时目录，检查结束后删除
+        auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        fs::path work_dir = fs::temp_directory_path() / ("configmanager_tests_" + std::to_string(stamp));
+        fs::create_directories(work_dir);
+
+        int failures = bounds_parity_checks();
+        failures += layered_refresh_checks(work_dir);
+        fs::remove_all(work_dir);
+        if (failures > 0) {
+            std::cerr << failures << " check(s) failed" << std::endl;
+            return EXIT_FAILURE;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "检查失败: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}